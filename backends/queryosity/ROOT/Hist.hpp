@@ -1,5 +1,6 @@
 #pragma once
 
+#include "TBufferFile.h"
 #include "TH1F.h"
 #include "TH2F.h"
 #include "TH3F.h"
@@ -8,7 +9,10 @@
 
 #include <queryosity.hpp>
 
+#include <istream>
 #include <memory>
+#include <ostream>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
@@ -139,12 +143,41 @@ std::shared_ptr<TH1> cloneHist(std::shared_ptr<TH1> hist) {
   return cloned;
 }
 
+// (de)serialize histograms through ROOT I/O, to be sent across processes
+template <typename H>
+void writeHist(std::ostream &out, std::shared_ptr<H> const &hist) {
+  TBufferFile buffer(TBuffer::kWrite);
+  buffer.WriteObject(hist.get());
+  const unsigned long long size = buffer.Length();
+  out.write(reinterpret_cast<char const *>(&size), sizeof(size));
+  out.write(buffer.Buffer(), size);
+}
+
+template <typename H> std::shared_ptr<H> readHist(std::istream &in) {
+  unsigned long long size = 0;
+  in.read(reinterpret_cast<char *>(&size), sizeof(size));
+  std::vector<char> data(in ? size : 0);
+  in.read(data.data(), data.size());
+  if (!in)
+    throw std::runtime_error("failed to read histogram");
+  TBufferFile buffer(TBuffer::kRead, data.size(), data.data(), kFALSE);
+  auto hist =
+      std::shared_ptr<H>(dynamic_cast<H *>(buffer.ReadObject(H::Class())));
+  if (!hist)
+    throw std::runtime_error("failed to read histogram");
+  hist->SetDirectory(nullptr);
+  return hist;
+}
+
 } // namespace
 
 namespace queryosity {
 
 namespace ROOT {
 
+/// Number of entries per batch filled into histograms.
+constexpr unsigned int batch_size = 1024;
+
 template <int Dim, typename Prec> class Hist;
 
 template <typename Prec>
@@ -157,14 +190,23 @@ public:
   virtual ~Hist() = default;
 
   virtual void fill(qty::column::observable<Prec>, double) final override;
+  virtual void fill_batch(std::vector<Prec> const &,
+                          std::vector<double> const &) final override;
+  virtual void reset() final override;
   virtual std::shared_ptr<TH1> result() const final override;
   virtual std::shared_ptr<TH1>
   merge(std::vector<std::shared_ptr<TH1>> const &results) const final override;
 
 protected:
+  virtual void write(std::ostream &out,
+                     std::shared_ptr<TH1> const &result) const final override;
+  virtual std::shared_ptr<TH1> read(std::istream &in) const final override;
+
   // histogram
   std::shared_ptr<TH1> m_hist; //!
   std::vector<Prec> m_xbins;
+  // batched values (converted for TH1::FillN)
+  std::vector<double> m_xvals;
 };
 
 template <typename Prec>
@@ -178,12 +220,22 @@ public:
 
   virtual void fill(qty::column::observable<Prec>,
                     qty::column::observable<Prec>, double) final override;
+  virtual void fill_batch(std::vector<Prec> const &, std::vector<Prec> const &,
+                          std::vector<double> const &) final override;
+  virtual void reset() final override;
   virtual std::shared_ptr<TH2> result() const final override;
   virtual std::shared_ptr<TH2>
   merge(std::vector<std::shared_ptr<TH2>> const &results) const final override;
 
 protected:
+  virtual void write(std::ostream &out,
+                     std::shared_ptr<TH2> const &result) const final override;
+  virtual std::shared_ptr<TH2> read(std::istream &in) const final override;
+
   std::shared_ptr<TH2> m_hist; //!
+  // batched values (converted for TH2::FillN)
+  std::vector<double> m_xvals;
+  std::vector<double> m_yvals;
 };
 
 template <typename Prec>
@@ -198,11 +250,16 @@ public:
   virtual void fill(qty::column::observable<Prec>,
                     qty::column::observable<Prec>,
                     qty::column::observable<Prec>, double) final override;
+  virtual void reset() final override;
   virtual std::shared_ptr<TH3> result() const final override;
   virtual std::shared_ptr<TH3>
   merge(std::vector<std::shared_ptr<TH3>> const &results) const final override;
 
 protected:
+  virtual void write(std::ostream &out,
+                     std::shared_ptr<TH3> const &result) const final override;
+  virtual std::shared_ptr<TH3> read(std::istream &in) const final override;
+
   std::shared_ptr<TH3> m_hist; //!
 };
 
@@ -217,11 +274,16 @@ public:
 
   virtual void fill(qty::column::observable<::ROOT::RVec<Prec>>,
                     double) final override;
+  virtual void reset() final override;
   virtual std::shared_ptr<TH1> result() const final override;
   virtual std::shared_ptr<TH1>
   merge(std::vector<std::shared_ptr<TH1>> const &results) const final override;
 
 protected:
+  virtual void write(std::ostream &out,
+                     std::shared_ptr<TH1> const &result) const final override;
+  virtual std::shared_ptr<TH1> read(std::istream &in) const final override;
+
   // histogram
   std::shared_ptr<TH1> m_hist; //!
 };
@@ -239,11 +301,16 @@ public:
   virtual void fill(qty::column::observable<::ROOT::RVec<Prec>>,
                     qty::column::observable<::ROOT::RVec<Prec>>,
                     double) final override;
+  virtual void reset() final override;
   virtual std::shared_ptr<TH2> result() const final override;
   virtual std::shared_ptr<TH2>
   merge(std::vector<std::shared_ptr<TH2>> const &results) const final override;
 
 protected:
+  virtual void write(std::ostream &out,
+                     std::shared_ptr<TH2> const &result) const final override;
+  virtual std::shared_ptr<TH2> read(std::istream &in) const final override;
+
   // histogram
   std::shared_ptr<TH2> m_hist; //!
 };
@@ -262,11 +329,16 @@ public:
                     qty::column::observable<::ROOT::RVec<Prec>>,
                     qty::column::observable<::ROOT::RVec<Prec>>,
                     double) final override;
+  virtual void reset() final override;
   virtual std::shared_ptr<TH3> result() const final override;
   virtual std::shared_ptr<TH3>
   merge(std::vector<std::shared_ptr<TH3>> const &results) const final override;
 
 protected:
+  virtual void write(std::ostream &out,
+                     std::shared_ptr<TH3> const &result) const final override;
+  virtual std::shared_ptr<TH3> read(std::istream &in) const final override;
+
   // histogram
   std::shared_ptr<TH3> m_hist; //!
 };
@@ -282,6 +354,7 @@ queryosity::ROOT::Hist<1, Prec>::Hist(const std::string &hname, unsigned int nbi
     : qty::query::definition<std::shared_ptr<TH1>(Prec)>() {
   m_hist = makeHist<1, Prec>(nbins, xmin, xmax);
   m_hist->SetNameTitle(hname.c_str(), hname.c_str());
+  this->set_batch_size(batch_size);
 }
 
 template <typename Prec>
@@ -293,6 +366,7 @@ queryosity::ROOT::Hist<1, Prec>::Hist(const std::string &hname, const std::vecto
   } else {
     m_hist =
         makeHist<1, Prec>(std::vector<double>(m_xbins.begin(), m_xbins.end()));
+    this->set_batch_size(batch_size);
   }
   m_hist->SetNameTitle(hname.c_str(), hname.c_str());
 }
@@ -310,6 +384,31 @@ void queryosity::ROOT::Hist<1, Prec>::fill(qty::column::observable<Prec> x, doub
   }
 }
 
+template <typename Prec>
+void queryosity::ROOT::Hist<1, Prec>::fill_batch(std::vector<Prec> const &xs,
+                                                 std::vector<double> const &ws) {
+  if constexpr (std::is_same_v<Prec, std::string>) {
+    qty::query::definition<std::shared_ptr<TH1>(Prec)>::fill_batch(xs, ws);
+  } else {
+    m_xvals.assign(xs.begin(), xs.end());
+    m_hist->FillN(m_xvals.size(), m_xvals.data(), ws.data());
+  }
+}
+
+template <typename Prec> void queryosity::ROOT::Hist<1, Prec>::reset() { m_hist->Reset(); }
+
+template <typename Prec>
+void queryosity::ROOT::Hist<1, Prec>::write(
+    std::ostream &out, std::shared_ptr<TH1> const &result) const {
+  writeHist(out, result);
+}
+
+template <typename Prec>
+std::shared_ptr<TH1>
+queryosity::ROOT::Hist<1, Prec>::read(std::istream &in) const {
+  return readHist<TH1>(in);
+}
+
 template <typename Prec> std::shared_ptr<TH1> queryosity::ROOT::Hist<1, Prec>::result() const {
   return m_hist;
 }
@@ -338,6 +437,7 @@ queryosity::ROOT::Hist<2, Prec>::Hist(const std::string &hname, const std::vecto
                     const std::vector<double> &ybins) {
   m_hist = std::static_pointer_cast<TH2>(makeHist<2, Prec>(xbins, ybins));
   m_hist->SetNameTitle(hname.c_str(), hname.c_str());
+  this->set_batch_size(batch_size);
 }
 
 template <typename Prec>
@@ -346,6 +446,15 @@ void queryosity::ROOT::Hist<2, Prec>::fill(qty::column::observable<Prec> x,
   m_hist->Fill(x.value(), y.value(), w);
 }
 
+template <typename Prec>
+void queryosity::ROOT::Hist<2, Prec>::fill_batch(std::vector<Prec> const &xs,
+                                                 std::vector<Prec> const &ys,
+                                                 std::vector<double> const &ws) {
+  m_xvals.assign(xs.begin(), xs.end());
+  m_yvals.assign(ys.begin(), ys.end());
+  m_hist->FillN(m_xvals.size(), m_xvals.data(), m_yvals.data(), ws.data());
+}
+
 template <typename Prec>
 std::shared_ptr<TH2>
 queryosity::ROOT::Hist<2, Prec>::merge(std::vector<std::shared_ptr<TH2>> const &results) const {
@@ -357,6 +466,20 @@ queryosity::ROOT::Hist<2, Prec>::merge(std::vector<std::shared_ptr<TH2>> const &
   return merged_result;
 }
 
+template <typename Prec> void queryosity::ROOT::Hist<2, Prec>::reset() { m_hist->Reset(); }
+
+template <typename Prec>
+void queryosity::ROOT::Hist<2, Prec>::write(
+    std::ostream &out, std::shared_ptr<TH2> const &result) const {
+  writeHist(out, result);
+}
+
+template <typename Prec>
+std::shared_ptr<TH2>
+queryosity::ROOT::Hist<2, Prec>::read(std::istream &in) const {
+  return readHist<TH2>(in);
+}
+
 template <typename Prec> std::shared_ptr<TH2> queryosity::ROOT::Hist<2, Prec>::result() const {
   return m_hist;
 }
@@ -389,6 +512,20 @@ queryosity::ROOT::Hist<3, Prec>::merge(std::vector<std::shared_ptr<TH3>> const &
   return merged_result;
 }
 
+template <typename Prec> void queryosity::ROOT::Hist<3, Prec>::reset() { m_hist->Reset(); }
+
+template <typename Prec>
+void queryosity::ROOT::Hist<3, Prec>::write(
+    std::ostream &out, std::shared_ptr<TH3> const &result) const {
+  writeHist(out, result);
+}
+
+template <typename Prec>
+std::shared_ptr<TH3>
+queryosity::ROOT::Hist<3, Prec>::read(std::istream &in) const {
+  return readHist<TH3>(in);
+}
+
 template <typename Prec> std::shared_ptr<TH3> queryosity::ROOT::Hist<3, Prec>::result() const {
   return m_hist;
 }
@@ -428,6 +565,23 @@ std::shared_ptr<TH1> queryosity::ROOT::Hist<1, ::ROOT::RVec<Prec>>::merge(
   return merged_result;
 }
 
+template <typename Prec>
+void queryosity::ROOT::Hist<1, ::ROOT::RVec<Prec>>::reset() {
+  m_hist->Reset();
+}
+
+template <typename Prec>
+void queryosity::ROOT::Hist<1, ::ROOT::RVec<Prec>>::write(
+    std::ostream &out, std::shared_ptr<TH1> const &result) const {
+  writeHist(out, result);
+}
+
+template <typename Prec>
+std::shared_ptr<TH1>
+queryosity::ROOT::Hist<1, ::ROOT::RVec<Prec>>::read(std::istream &in) const {
+  return readHist<TH1>(in);
+}
+
 template <typename Prec>
 std::shared_ptr<TH1> queryosity::ROOT::Hist<1, ::ROOT::RVec<Prec>>::result() const {
   return m_hist;
@@ -464,6 +618,23 @@ std::shared_ptr<TH2> queryosity::ROOT::Hist<2, ::ROOT::RVec<Prec>>::merge(
   return merged_result;
 }
 
+template <typename Prec>
+void queryosity::ROOT::Hist<2, ::ROOT::RVec<Prec>>::reset() {
+  m_hist->Reset();
+}
+
+template <typename Prec>
+void queryosity::ROOT::Hist<2, ::ROOT::RVec<Prec>>::write(
+    std::ostream &out, std::shared_ptr<TH2> const &result) const {
+  writeHist(out, result);
+}
+
+template <typename Prec>
+std::shared_ptr<TH2>
+queryosity::ROOT::Hist<2, ::ROOT::RVec<Prec>>::read(std::istream &in) const {
+  return readHist<TH2>(in);
+}
+
 template <typename Prec>
 std::shared_ptr<TH2> queryosity::ROOT::Hist<2, ::ROOT::RVec<Prec>>::result() const {
   return m_hist;
@@ -506,6 +677,23 @@ std::shared_ptr<TH3> queryosity::ROOT::Hist<3, ::ROOT::RVec<Prec>>::merge(
   return merged_result;
 }
 
+template <typename Prec>
+void queryosity::ROOT::Hist<3, ::ROOT::RVec<Prec>>::reset() {
+  m_hist->Reset();
+}
+
+template <typename Prec>
+void queryosity::ROOT::Hist<3, ::ROOT::RVec<Prec>>::write(
+    std::ostream &out, std::shared_ptr<TH3> const &result) const {
+  writeHist(out, result);
+}
+
+template <typename Prec>
+std::shared_ptr<TH3>
+queryosity::ROOT::Hist<3, ::ROOT::RVec<Prec>>::read(std::istream &in) const {
+  return readHist<TH3>(in);
+}
+
 template <typename Prec>
 std::shared_ptr<TH3> queryosity::ROOT::Hist<3, ::ROOT::RVec<Prec>>::result() const {
   return m_hist;
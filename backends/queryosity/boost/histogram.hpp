@@ -3,8 +3,15 @@
 #include <boost/histogram.hpp> // make_histogram, regular, weight, indexed
 #include <boost/histogram/ostream.hpp>
 
+#include <array>
 #include <functional>          // std::ref
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <stdexcept>
+#include <type_traits>
 #include <utility>
+#include <vector>
 
 namespace queryosity {
 
@@ -50,6 +57,17 @@ class histogram
     : public queryosity::query::definition<std::shared_ptr<histogram_t>(Vals...)> {
 
 public:
+  /// Whether the input columns can be filled in batches (numerical values of a
+  /// common type).
+  static constexpr bool batchable =
+      std::conjunction_v<std::is_arithmetic<Vals>...,
+                         std::negation<std::is_same<Vals, bool>>...> &&
+      std::conjunction_v<
+          std::is_same<Vals, std::tuple_element_t<0, std::tuple<Vals...>>>...>;
+
+  /// Number of entries per batch.
+  static constexpr unsigned int batch_size = 1024;
+
 public:
   /**
    * @brief Constructor with axis configurations.
@@ -68,6 +86,31 @@ public:
   virtual void fill(queryosity::column::observable<Vals>... columns,
                     double weight) final override;
 
+  /**
+   * @brief Fill histogram and its variations with input columns.
+   * @param columns Input column observables.
+   * @param qrys Histograms to be filled.
+   * @param ws Selection weight value of each histogram.
+   * @details The bin of the input column values is located once, and
+   * incremented in the storage of each histogram by its weight.
+   */
+  virtual void fill_variations(queryosity::column::observable<Vals>... columns,
+                               std::vector<queryosity::query::node *> const &qrys,
+                               std::vector<double> const &ws) final override;
+
+  /**
+   * @brief Fill histogram with a batch of input column values at once.
+   * @param columns Input column values.
+   * @param ws Selection weight value of each entry.
+   */
+  virtual void fill_batch(std::vector<Vals> const &...columns,
+                          std::vector<double> const &ws) final override;
+
+  /**
+   * @brief Reset the contents of the histogram.
+   */
+  virtual void reset() final override;
+
   /**
    * @brief Retrieve the result.
    * @return The (smart pointer to) histogram.
@@ -82,6 +125,23 @@ public:
   virtual std::shared_ptr<histogram_t>
   merge(std::vector<std::shared_ptr<histogram_t>> const &results) const final override;
 
+protected:
+  /**
+   * @brief Write the bin contents of a histogram.
+   */
+  virtual void write(std::ostream &out,
+                     std::shared_ptr<histogram_t> const &result) const final override;
+
+  /**
+   * @brief Read bin contents into a histogram with the same axes.
+   */
+  virtual std::shared_ptr<histogram_t> read(std::istream &in) const final override;
+
+  template <std::size_t... Is>
+  bool locate(std::array<::boost::histogram::axis::index_type,
+                         sizeof...(Vals)> &bin,
+              Vals const &...values, std::index_sequence<Is...>) const;
+
 protected:
   std::shared_ptr<histogram_t> m_histogram;
 };
@@ -98,6 +158,8 @@ template <typename... Axes>
 queryosity::boost::histogram::histogram<Vals...>::histogram(Axes &&...axes) {
   m_histogram = std::make_shared<histogram_t>(std::move(
       ::boost::histogram::make_weighted_histogram(std::forward<Axes>(axes)...)));
+  if constexpr (batchable)
+    this->set_batch_size(batch_size);
 }
 
 template <typename... Vals>
@@ -106,6 +168,61 @@ void queryosity::boost::histogram::histogram<Vals...>::fill(
   (*m_histogram)(columns.value()..., ::boost::histogram::weight(w));
 }
 
+template <typename... Vals>
+void queryosity::boost::histogram::histogram<Vals...>::fill_variations(
+    queryosity::column::observable<Vals>... columns,
+    std::vector<queryosity::query::node *> const &qrys,
+    std::vector<double> const &ws) {
+  std::array<::boost::histogram::axis::index_type, sizeof...(Vals)> bin;
+  // values outside of all bins are dropped, as in a regular fill
+  if (!this->locate(bin, columns.value()...,
+                    std::index_sequence_for<Vals...>()))
+    return;
+  for (unsigned int i = 0; i < qrys.size(); ++i) {
+    std::apply(
+        [&](auto... is) {
+          static_cast<histogram *>(qrys[i])->m_histogram->at(is...) += ws[i];
+        },
+        bin);
+  }
+}
+
+template <typename... Vals>
+void queryosity::boost::histogram::histogram<Vals...>::fill_batch(
+    std::vector<Vals> const &...columns, std::vector<double> const &ws) {
+  if constexpr (!batchable) {
+    queryosity::query::definition<std::shared_ptr<histogram_t>(
+        Vals...)>::fill_batch(columns..., ws);
+  } else if constexpr (sizeof...(Vals) == 1) {
+    m_histogram->fill(columns..., ::boost::histogram::weight(ws));
+  } else {
+    m_histogram->fill(std::array{columns...}, ::boost::histogram::weight(ws));
+  }
+}
+
+template <typename... Vals>
+template <std::size_t... Is>
+bool queryosity::boost::histogram::histogram<Vals...>::locate(
+    std::array<::boost::histogram::axis::index_type, sizeof...(Vals)> &bin,
+    Vals const &...values, std::index_sequence<Is...>) const {
+  auto in_range = [this](unsigned int iaxis,
+                         ::boost::histogram::axis::index_type idx) {
+    auto const &ax = m_histogram->axis(iaxis);
+    auto const opts = ax.options();
+    return (idx >= 0 && idx < ax.size()) ||
+           (idx == -1 && (opts & ::boost::histogram::axis::option::underflow)) ||
+           (idx == ax.size() &&
+            (opts & ::boost::histogram::axis::option::overflow));
+  };
+  ((bin[Is] = m_histogram->axis(Is).index(values)), ...);
+  return (in_range(Is, bin[Is]) && ...);
+}
+
+template <typename... Vals>
+void queryosity::boost::histogram::histogram<Vals...>::reset() {
+  m_histogram->reset();
+}
+
 template <typename... Vals>
 std::shared_ptr<queryosity::boost::histogram::histogram_t>
 queryosity::boost::histogram::histogram<Vals...>::result() const {
@@ -122,4 +239,33 @@ queryosity::boost::histogram::histogram<Vals...>::merge(
     *sum += *result;
   }
   return sum;
-}
\ No newline at end of file
+}
+
+template <typename... Vals>
+void queryosity::boost::histogram::histogram<Vals...>::write(
+    std::ostream &out, std::shared_ptr<histogram_t> const &result) const {
+  // axes are known to the receiving end: only the cells need to be sent
+  const unsigned long long ncells = result->size();
+  out.write(reinterpret_cast<char const *>(&ncells), sizeof(ncells));
+  for (auto &&cell : *result) {
+    const double value = cell;
+    out.write(reinterpret_cast<char const *>(&value), sizeof(value));
+  }
+}
+
+template <typename... Vals>
+std::shared_ptr<queryosity::boost::histogram::histogram_t>
+queryosity::boost::histogram::histogram<Vals...>::read(std::istream &in) const {
+  auto received = std::make_shared<histogram_t>(*m_histogram);
+  received->reset();
+  unsigned long long ncells = 0;
+  in.read(reinterpret_cast<char *>(&ncells), sizeof(ncells));
+  if (in && ncells != received->size())
+    throw std::runtime_error("histogram received with a different binning");
+  for (auto &&cell : *received) {
+    double value = 0.0;
+    in.read(reinterpret_cast<char *>(&value), sizeof(value));
+    cell = value;
+  }
+  return received;
+}
@@ -31,6 +31,11 @@ public:
   virtual std::vector<std::pair<unsigned long long, unsigned long long>>
   partition() final override;
 
+  /**
+   * @brief Entries are held in-memory, i.e. can be accessed in any order.
+   */
+  virtual bool is_splittable() const final override { return true; }
+
   /**
    * @brief Read a column.
    * @tparam T Column data type.
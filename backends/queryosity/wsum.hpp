@@ -15,6 +15,7 @@ public:
   ~wsum() = default;
 
   virtual void fill(queryosity::column::observable<double>, double) override;
+  virtual void reset() override;
   virtual double result() const override;
   virtual double merge(std::vector<double> const &results) const override;
 
@@ -29,6 +30,8 @@ void queryosity::wsum::fill(queryosity::column::observable<double> x,
   m_result += w * x.value();
 }
 
+void queryosity::wsum::reset() { m_result = 0.0; }
+
 double queryosity::wsum::result() const { return m_result; }
 
 double queryosity::wsum::merge(std::vector<double> const &results) const {
@@ -8,6 +8,8 @@
 
 #include "queryosity/multithread.hpp"
 
+#include "queryosity/dataset_cached.hpp"
+#include "queryosity/dataset_pipelined.hpp"
 #include "queryosity/dataset_reader.hpp"
 
 #include "queryosity/column_definition.hpp"
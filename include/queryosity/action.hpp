@@ -12,10 +12,17 @@ namespace queryosity {
  * @details The order of execution of an action's methods are as follows:
  * 1. `vary()` immediately after the instantiation of an action (if it is not nominal).
  * 2. `initialize()` before entering the entry loop.
- * 3. `execute()` for each entry.
+ * 3. `execute()` for each entry (columns and selections, which are computed
+ *    on-demand, are not executed by the dataflow, unless a column overrides
+ *    it).
  * 4. `finalize()` after exiting the entry loop.
+ *
+ * Actions are aligned to (and sized in whole) 64-byte cache lines. The
+ * instances of an action for each thread slot are allocated one after another,
+ * so this prevents the per-entry writes by one slot from invalidating the
+ * cache line of another.
 */
-class action {
+class alignas(64) action {
 
 public:
   action() = default;
@@ -55,4 +62,4 @@ protected:
 
 } // namespace queryosity
 
-inline void queryosity::action::vary(const std::string &) {}
\ No newline at end of file
+inline void queryosity::action::vary(const std::string &) {}
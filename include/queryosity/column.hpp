@@ -13,10 +13,27 @@ namespace queryosity {
  */
 namespace column {
 
+/**
+ * @brief Entry being processed by a thread slot.
+ * @details The epoch is advanced once per entry, such that columns can tell
+ * whether their cached values are up-to-date without having to be reset for
+ * every entry.
+ */
+struct cursor {
+  unsigned int slot = 0;
+  unsigned long long entry = 0;
+  unsigned long long epoch = 0;
+};
+
 class node : public action {
   public:
-    node() = default;
+    node();
     virtual ~node() = default;
+
+    void set_cursor(cursor const *cur) { m_cursor = cur; }
+
+  protected:
+    cursor const *m_cursor;
 };
 
 //---------------------------------------------------
@@ -162,14 +179,26 @@ template <typename> class definition;
 
 template <typename, typename U> class conversion;
 
-template <typename> class equation;
+template <typename, typename = void> class equation;
 
 template <typename> class composition;
 
 template <typename> class evaluator;
 
+template <typename> class vectorized;
+
+template <typename> class lane;
+
+template <typename> class lanewise;
+
+template <typename, typename...> class fused;
+
 template <typename> struct constant;
 
+template <typename...> struct conjunction;
+
+class intersection;
+
 template <typename> struct expression;
 
 template <typename> struct series;
@@ -191,8 +220,9 @@ constexpr std::true_type
 check_definition(typename column::definition<T> const &);
 constexpr std::false_type check_definition(...);
 
-template <typename T>
-constexpr std::true_type check_equation(typename column::equation<T> const &);
+template <typename T, typename Fn>
+constexpr std::true_type
+check_equation(typename column::equation<T, Fn> const &);
 constexpr std::false_type check_equation(...);
 
 template <typename T>
@@ -226,22 +256,47 @@ struct is_evaluator<column::evaluator<T>> : std::true_type {};
 
 template <typename T> constexpr bool is_evaluatable_v = is_evaluator<T>::value;
 
-template <typename Fn> struct deduce_equation;
+// equation whose callable is fully determined by its type
+template <typename T> struct is_stateless_equation : std::false_type {};
+template <typename Sig, typename Fn>
+struct is_stateless_equation<column::equation<Sig, Fn>>
+    : std::bool_constant<std::is_class_v<Fn> && std::is_empty_v<Fn>> {};
+
+template <typename T>
+constexpr bool is_stateless_equation_v = is_stateless_equation<T>::value;
+
+template <typename Sig, typename Fn> struct deduce_equation;
 
-template <typename Ret, typename... Args>
-struct deduce_equation<std::function<Ret(Args...)>> {
-  using type = column::equation<std::decay_t<Ret>(std::decay_t<Args>...)>;
+// the callable is stored as-is, unless it is already type-erased
+template <typename Ret, typename... Args, typename Fn>
+struct deduce_equation<std::function<Ret(Args...)>, Fn> {
+  using type = column::equation<
+      std::decay_t<Ret>(std::decay_t<Args>...),
+      std::conditional_t<std::is_same_v<Fn, std::function<Ret(Args...)>>, void,
+                         Fn>>;
 };
 
 template <typename Fn>
-using equation_t = typename deduce_equation<
-    typename column::expression<Fn>::function_type>::type;
+using equation_t =
+    typename deduce_equation<decltype(std::function(std::declval<Fn>())),
+                             std::decay_t<Fn>>::type;
 
 template <typename T> using evaluated_t = typename T::evaluated_type;
 
 template <typename T>
 using value_t = std::decay_t<decltype(std::declval<T>().value())>;
 
+template <typename T, typename Execute = decltype(&T::execute)>
+constexpr bool overrides_execute_v = !(
+    std::is_same_v<Execute,
+                   void (valued<value_t<T>>::*)(unsigned int,
+                                                unsigned long long)> ||
+    std::is_same_v<Execute,
+                   void (calculation<value_t<T>>::*)(unsigned int,
+                                                     unsigned long long)> ||
+    std::is_same_v<Execute, void (reader<value_t<T>>::*)(unsigned int,
+                                                         unsigned long long)>);
+
 } // namespace column
 
 template <typename T>
@@ -253,6 +308,12 @@ template <typename T>
 void queryosity::column::valued<T>::initialize(unsigned int, unsigned long long,
                                                unsigned long long) {}
 
+inline queryosity::column::node::node() {
+  // columns not attached to a computation stay at the same entry
+  static const cursor detached;
+  m_cursor = &detached;
+}
+
 template <typename T>
 void queryosity::column::valued<T>::execute(unsigned int, unsigned long long) {}
 
@@ -9,6 +9,8 @@ namespace queryosity {
  * @tparam Val Column value type.
  * @details A calculation is performed once per-entry (if needed) and its value
  * is stored for multiple accesses by downstream actions within the entry.
+ * The stored value is out-of-date once the epoch of the entry being processed
+ * has advanced past the one at which it was calculated.
  * The type `Val` must be *CopyConstructible* and *CopyAssignable*.
  */
 template <typename Val> class column::calculation : public valued<Val> {
@@ -25,6 +27,15 @@ public:
 
   virtual Val calculate() const = 0;
 
+  /**
+   * @brief Calculate the value in-place.
+   * @param[in,out] value Value of the previous entry, to be overwritten.
+   * @details By default, the value is simply assigned from `calculate()`.
+   * Overriding it allows any resources held by the value (e.g. the capacity of
+   * a container) to be re-used across entries.
+   */
+  virtual void calculate_into(Val &value) const;
+
   virtual void initialize(unsigned int slot, unsigned long long begin,
                           unsigned long long end) override;
   virtual void execute(unsigned int slot, unsigned long long entry) override;
@@ -36,36 +47,41 @@ protected:
 
 protected:
   mutable Val m_value;
-  mutable bool m_updated;
+  mutable unsigned long long m_epoch;
 };
 
 } // namespace queryosity
 
 template <typename Val>
 queryosity::column::calculation<Val>::calculation()
-    : m_value(), m_updated(false) {}
+    : m_value(), m_epoch(~0ULL) {}
 
 template <typename Val>
 template <typename... Args>
 queryosity::column::calculation<Val>::calculation(Args &&...args)
-    : m_value(std::forward<Args>(args)...) {}
+    : m_value(std::forward<Args>(args)...), m_epoch(~0ULL) {}
 
 template <typename Val>
 const Val &queryosity::column::calculation<Val>::value() const {
-  if (!m_updated)
+  if (m_epoch != this->m_cursor->epoch)
     this->update();
   return m_value;
 }
 
 template <typename Val>
 void queryosity::column::calculation<Val>::update() const {
-  m_value = std::move(this->calculate());
-  m_updated = true;
+  this->calculate_into(m_value);
+  m_epoch = this->m_cursor->epoch;
+}
+
+template <typename Val>
+void queryosity::column::calculation<Val>::calculate_into(Val &value) const {
+  value = this->calculate();
 }
 
 template <typename Val>
 void queryosity::column::calculation<Val>::reset() const {
-  m_updated = false;
+  m_epoch = ~0ULL;
 }
 
 template <typename Val>
@@ -32,18 +32,39 @@ public:
   auto define(Args const &...vars) const
       -> std::unique_ptr<evaluator<Def>>;
 
-  template <typename Ret, typename... Args>
-  auto equate(std::function<Ret(Args...)> fn) const -> std::unique_ptr<
-      evaluator<equation<std::decay_t<Ret>(std::decay_t<Args>...)>>>;
+  template <typename Fn>
+  auto equate(Fn fn) const -> std::unique_ptr<evaluator<equation_t<Fn>>>;
 
   template <typename Def, typename... Cols>
   auto evaluate(evaluator<Def> const&calc, Cols const &...cols) -> Def *;
 
+  template <typename... Cols>
+  auto intersect(Cols const &...decs) -> intersection *;
+
+  template <typename Fn, typename... Cols>
+  auto fuse(Fn const &fn, Cols const &...cols) -> fused<Fn, Cols...> *;
+
+  template <typename Col>
+  auto vectorize(std::vector<Col const *> const &lanes)
+      -> vectorized<value_t<Col>> *;
+
+  template <typename Def, typename... Cols>
+  auto evaluate_lanes(evaluator<Def> const &calc,
+                      std::vector<Cols const *> const &...lanes)
+      -> lanewise<Def> *;
+
+  template <typename Lns>
+  auto index_lane(Lns const &lanes, unsigned int index)
+      -> lane<typename value_t<Lns>::value_type> *;
+
 protected:
   template <typename Col> auto add_column(std::unique_ptr<Col> col) -> Col *;
 
 protected:
   std::vector<std::unique_ptr<column::node>> m_columns;
+  // columns that still need to be executed for each entry
+  std::vector<column::node *> m_executed_columns;
+  column::cursor m_cursor;
 };
 
 }
@@ -54,6 +75,9 @@ protected:
 #include "column_equation.hpp"
 #include "column_evaluator.hpp"
 #include "column_fixed.hpp"
+#include "column_fused.hpp"
+#include "column_intersection.hpp"
+#include "column_vectorized.hpp"
 #include "dataset_reader.hpp"
 
 template <typename DS, typename Val>
@@ -85,13 +109,10 @@ auto queryosity::column::computation::define(Args const &...args) const
   return std::make_unique<evaluator<Def>>(args...);
 }
 
-template <typename Ret, typename... Args>
-auto queryosity::column::computation::equate(std::function<Ret(Args...)> fn)
-    const -> std::unique_ptr<
-      evaluator<equation<std::decay_t<Ret>(std::decay_t<Args>...)>>> {
-  return std::make_unique<
-      evaluator<equation<std::decay_t<Ret>(std::decay_t<Args>...)>>>(
-      fn);
+template <typename Fn>
+auto queryosity::column::computation::equate(Fn fn) const
+    -> std::unique_ptr<evaluator<equation_t<Fn>>> {
+  return std::make_unique<evaluator<equation_t<Fn>>>(fn);
 }
 
 template <typename Def, typename... Cols>
@@ -101,10 +122,54 @@ auto queryosity::column::computation::evaluate(evaluator<Def> const &calc,
   return this->add_column(std::move(defn));
 }
 
+template <typename... Cols>
+auto queryosity::column::computation::intersect(Cols const &...decs)
+    -> intersection * {
+  auto itx = std::make_unique<intersection>(decs...);
+  return this->add_column(std::move(itx));
+}
+
+template <typename Fn, typename... Cols>
+auto queryosity::column::computation::fuse(Fn const &fn, Cols const &...cols)
+    -> fused<Fn, Cols...> * {
+  auto fsd = std::make_unique<fused<Fn, Cols...>>(fn, cols...);
+  return this->add_column(std::move(fsd));
+}
+
+template <typename Col>
+auto queryosity::column::computation::vectorize(
+    std::vector<Col const *> const &lanes) -> vectorized<value_t<Col>> * {
+  auto vec = std::make_unique<vectorized<value_t<Col>>>();
+  vec->set_arguments(std::vector<view<value_t<Col>> const *>(lanes.begin(),
+                                                             lanes.end()));
+  return this->add_column(std::move(vec));
+}
+
+template <typename Def, typename... Cols>
+auto queryosity::column::computation::evaluate_lanes(
+    evaluator<Def> const &calc, std::vector<Cols const *> const &...lanes)
+    -> lanewise<Def> * {
+  auto lnw = std::make_unique<lanewise<Def>>();
+  lnw->set_arguments(calc, lanes...);
+  return this->add_column(std::move(lnw));
+}
+
+template <typename Lns>
+auto queryosity::column::computation::index_lane(Lns const &lanes,
+                                                 unsigned int index)
+    -> lane<typename value_t<Lns>::value_type> * {
+  auto lns = std::make_unique<lane<typename value_t<Lns>::value_type>>(lanes,
+                                                                       index);
+  return this->add_column(std::move(lns));
+}
+
 template <typename Col>
 auto queryosity::column::computation::add_column(std::unique_ptr<Col> col)
     -> Col * {
   auto out = col.get();
+  out->set_cursor(&m_cursor);
+  if constexpr (overrides_execute_v<Col>)
+    m_executed_columns.push_back(out);
   m_columns.push_back(std::move(col));
   return out;
 }
\ No newline at end of file
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <tuple>
+
+#include "column.hpp"
+
+namespace queryosity {
+
+class dataflow;
+
+template <typename Val> class lazy;
+
+namespace column {
+
+/**
+ * @ingroup api
+ * @brief Argument to define the intersection of commuting cut decisions.
+ * @tparam Cols Input column types.
+ * @details The decisions must be free of side-effects, as each of them may or
+ * may not be evaluated for any given entry.
+ */
+template <typename... Cols> struct conjunction {
+
+public:
+  /**
+   * @brief Argument constructor.
+   * @param[in] decs Lazy input columns used as decisions.
+   */
+  conjunction(lazy<Cols> const &...decs);
+  ~conjunction() = default;
+
+  auto _intersect(dataflow &df) const -> lazy<column::intersection>;
+
+protected:
+  std::tuple<lazy<Cols>...> m_decisions;
+};
+
+} // namespace column
+
+} // namespace queryosity
+
+#include "dataflow.hpp"
+#include "lazy.hpp"
+
+template <typename... Cols>
+queryosity::column::conjunction<Cols...>::conjunction(lazy<Cols> const &...decs)
+    : m_decisions(decs...) {}
+
+template <typename... Cols>
+auto queryosity::column::conjunction<Cols...>::_intersect(
+    queryosity::dataflow &df) const -> lazy<column::intersection> {
+  return std::apply(
+      [&df](lazy<Cols> const &...decs) { return df._intersect(decs...); },
+      m_decisions);
+}
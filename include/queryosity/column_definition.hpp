@@ -2,6 +2,7 @@
 
 #include <memory>
 #include <tuple>
+#include <type_traits>
 
 #include "column_calculation.hpp"
 #include "column_evaluator.hpp"
@@ -31,14 +32,28 @@ public:
 
 public:
   virtual Out calculate() const final override;
+  virtual void calculate_into(Out &value) const final override;
 
   /**
    * @brief Compute the quantity of interest for the entry
    * @note Columns observables are not computed until `value()` is
    * called.
    * @param[in] args Input column observables.
+   * @details By default, the quantity is computed in-place by `evaluate_into()`
+   * on a copy of the value of the previous entry. At least one of the two must
+   * be overridden, which is checked at compile-time.
    */
-  virtual Out evaluate(observable<Ins>... args) const = 0;
+  virtual Out evaluate(observable<Ins>... args) const;
+
+  /**
+   * @brief Compute the quantity of interest for the entry in-place.
+   * @param[in,out] value Quantity of the previous entry, to be overwritten.
+   * @param[in] args Input column observables.
+   * @details By default, the quantity is assigned from `evaluate()`.
+   * Overriding it allows e.g. container values to keep their capacity across
+   * entries.
+   */
+  virtual void evaluate_into(Out &value, observable<Ins>... args) const;
 
   template <typename... Args> void set_arguments(const view<Args> &...args);
 
@@ -46,6 +61,26 @@ protected:
   vartuple_type m_arguments;
 };
 
+namespace column {
+
+template <typename Out, typename... Ins>
+definition<Out(Ins...)> const &
+definition_base(definition<Out(Ins...)> const &);
+
+template <typename Def>
+using definition_base_t =
+    std::decay_t<decltype(definition_base(std::declval<Def const &>()))>;
+
+// whether at least one of evaluate() or evaluate_into() is overridden
+template <typename Def>
+constexpr bool overrides_evaluate_v =
+    !std::is_same_v<decltype(&Def::evaluate),
+                    decltype(&definition_base_t<Def>::evaluate)> ||
+    !std::is_same_v<decltype(&Def::evaluate_into),
+                    decltype(&definition_base_t<Def>::evaluate_into)>;
+
+} // namespace column
+
 /**
  * @ingroup api
  * @brief Argument to define a custom column in the dataflow.
@@ -96,9 +131,36 @@ Out queryosity::column::definition<Out(Ins...)>::calculate() const {
       m_arguments);
 }
 
+template <typename Out, typename... Ins>
+void queryosity::column::definition<Out(Ins...)>::calculate_into(
+    Out &value) const {
+  std::apply(
+      [this, &value](const variable<Ins> &...args) {
+        this->evaluate_into(value, args...);
+      },
+      m_arguments);
+}
+
+template <typename Out, typename... Ins>
+Out queryosity::column::definition<Out(Ins...)>::evaluate(
+    observable<Ins>... args) const {
+  Out value = this->m_value;
+  this->evaluate_into(value, args...);
+  return value;
+}
+
+template <typename Out, typename... Ins>
+void queryosity::column::definition<Out(Ins...)>::evaluate_into(
+    Out &value, observable<Ins>... args) const {
+  value = this->evaluate(args...);
+}
+
 template <typename Def>
 template <typename... Args>
 queryosity::column::definition<Def>::definition(Args const &...args) {
+  static_assert(overrides_evaluate_v<Def>,
+                "a column definition must override evaluate() or "
+                "evaluate_into()");
   m_define = [args...](computation &comp) { return comp.define<Def>(args...); };
 }
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <functional>
+#include <type_traits>
 
 #include "column_definition.hpp"
 
@@ -8,16 +9,24 @@ namespace queryosity {
 
 namespace column {
 
-template <typename Out, typename... Ins>
-class equation<Out(Ins...)> : public definition<Out(Ins...)> {
+/**
+ * @brief Column evaluated out of a callable.
+ * @tparam Out Output value type.
+ * @tparam Ins Input value types.
+ * @tparam Fn Callable type, or `void` to hold it as a `std::function`.
+ * @details A concrete callable type allows its calls to be in-lined.
+ */
+template <typename Out, typename... Ins, typename Fn>
+class equation<Out(Ins...), Fn> : public definition<Out(Ins...)> {
 
 public:
   using vartuple_type = typename definition<Out(Ins...)>::vartuple_type;
-  using function_type =
-      std::function<std::decay_t<Out>(std::decay_t<Ins> const &...)>;
+  using function_type = std::conditional_t<
+      std::is_void_v<Fn>,
+      std::function<std::decay_t<Out>(std::decay_t<Ins> const &...)>, Fn>;
 
 public:
-  template <typename Fn> equation(Fn&& fn);
+  template <typename Callable> equation(Callable&& fn);
   virtual ~equation() = default;
 
 public:
@@ -25,39 +34,34 @@ public:
 
   virtual void initialize(unsigned int slot, unsigned long long begin,
                           unsigned long long end) final override;
-  virtual void execute(unsigned int slot, unsigned long long entry) final override;
   virtual void finalize(unsigned int slot) final override;
 
 protected:
-  function_type m_evaluate;
+  // (non-const) callables are invoked as they would be by std::function
+  mutable function_type m_evaluate;
 };
 
 } // namespace column
 
 } // namespace queryosity
 
-template <typename Out, typename... Ins>
-template <typename Fn>
-queryosity::column::equation<Out(Ins...)>::equation(Fn&& fn) : m_evaluate(std::forward<Fn>(fn)) {}
+template <typename Out, typename... Ins, typename Fn>
+template <typename Callable>
+queryosity::column::equation<Out(Ins...), Fn>::equation(Callable&& fn) : m_evaluate(std::forward<Callable>(fn)) {}
 
-template <typename Out, typename... Ins>
-Out queryosity::column::equation<Out(Ins...)>::evaluate(
+template <typename Out, typename... Ins, typename Fn>
+Out queryosity::column::equation<Out(Ins...), Fn>::evaluate(
     observable<Ins>... args) const {
   return this->m_evaluate(args.value()...);
 }
 
-template <typename Out, typename... Ins>
-void queryosity::column::equation<Out(Ins...)>::initialize(unsigned int slot, unsigned long long begin,
+template <typename Out, typename... Ins, typename Fn>
+void queryosity::column::equation<Out(Ins...), Fn>::initialize(unsigned int slot, unsigned long long begin,
                                                unsigned long long end) {
   calculation<Out>::initialize(slot, begin, end);
                                                }
 
-template <typename Out, typename... Ins>
-void queryosity::column::equation<Out(Ins...)>::execute(unsigned int slot, unsigned long long entry) {
-  calculation<Out>::execute(slot, entry);
-}
-
-template <typename Out, typename... Ins>
-void queryosity::column::equation<Out(Ins...)>::finalize(unsigned int slot) {
+template <typename Out, typename... Ins, typename Fn>
+void queryosity::column::equation<Out(Ins...), Fn>::finalize(unsigned int slot) {
   calculation<Out>::finalize(slot);
 }
\ No newline at end of file
@@ -27,6 +27,9 @@ namespace column {
  */
 template <typename Expr> struct expression {
 
+public:
+  template <typename> friend struct expression;
+
 public:
   using function_type = decltype(std::function(std::declval<Expr>()));
   using equation_type = equation_t<Expr>;
@@ -39,6 +42,12 @@ public:
   expression(Expr expr);
   ~expression() = default;
 
+  /**
+   * @brief Conversion constructor (e.g. into a type-erased expression).
+   * @param[in] other Expression of another callable type.
+   */
+  template <typename Other> expression(expression<Other> const &other);
+
   auto _equate(dataflow &df) const;
 
   template <typename Sel> auto _select(dataflow &df) const;
@@ -47,7 +56,7 @@ public:
   auto _select(dataflow &df, lazy<selection::node> const &presel) const;
 
 protected:
-  function_type m_expression;
+  Expr m_expression;
 };
 
 } // namespace column
@@ -62,6 +71,12 @@ template <typename Expr>
 queryosity::column::expression<Expr>::expression(Expr expr)
     : m_expression(std::move(expr)) {}
 
+template <typename Expr>
+template <typename Other>
+queryosity::column::expression<Expr>::expression(
+    expression<Other> const &other)
+    : m_expression(other.m_expression) {}
+
 template <typename Expr>
 auto queryosity::column::expression<Expr>::_equate(
     queryosity::dataflow &df) const {
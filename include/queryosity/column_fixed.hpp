@@ -18,7 +18,6 @@ public:
 
   virtual void initialize(unsigned int slot, unsigned long long begin,
                           unsigned long long end) final override;
-  virtual void execute(unsigned int slot, unsigned long long entry) final override;
   virtual void finalize(unsigned int slot) final override;
 
 protected:
@@ -46,11 +45,6 @@ void queryosity::column::fixed<Val>::initialize(unsigned int slot, unsigned long
   valued<Val>::initialize(slot, begin, end);
                                                }
 
-template <typename Val>
-void queryosity::column::fixed<Val>::execute(unsigned int slot, unsigned long long entry) {
-  valued<Val>::execute(slot, entry);
-}
-
 template <typename Val>
 void queryosity::column::fixed<Val>::finalize(unsigned int slot) {
   valued<Val>::finalize(slot);
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "column.hpp"
+#include "column_calculation.hpp"
+
+namespace queryosity {
+
+namespace column {
+
+/**
+ * @brief Column computed by an operator out of its operand columns.
+ * @tparam Fn Operator type.
+ * @tparam Cols Operand column types.
+ * @details Operands that are themselves fused columns are evaluated through
+ * their concrete type, such that a chain of operators is computed without any
+ * virtual calls in-between. Their values are still cached per-entry, so an
+ * operand shared by multiple columns is only computed once.
+ */
+template <typename Fn, typename... Cols>
+class fused
+    : public calculation<std::decay_t<std::invoke_result_t<
+          Fn const &, value_t<Cols> const &...>>> {
+
+public:
+  using value_type = std::decay_t<
+      std::invoke_result_t<Fn const &, value_t<Cols> const &...>>;
+
+public:
+  fused(Fn fn, Cols const &...cols);
+  virtual ~fused() = default;
+
+  virtual value_type calculate() const final override;
+
+  /**
+   * @brief Compute the value of the column without caching it.
+   */
+  value_type compute() const;
+
+  /**
+   * @brief Get the (cached) value of the column without virtual calls.
+   */
+  value_type const &evaluate() const;
+
+protected:
+  template <typename Col> static decltype(auto) operand(Col const &col);
+
+protected:
+  Fn m_fn;
+  std::tuple<Cols const *...> m_operands;
+};
+
+template <typename Fn, typename... Cols>
+constexpr std::true_type check_fused(fused<Fn, Cols...> const &);
+constexpr std::false_type check_fused(...);
+
+template <typename T>
+constexpr bool is_fused_v =
+    decltype(check_fused(std::declval<std::decay_t<T> const &>()))::value;
+
+} // namespace column
+
+} // namespace queryosity
+
+template <typename Fn, typename... Cols>
+queryosity::column::fused<Fn, Cols...>::fused(Fn fn, Cols const &...cols)
+    : m_fn(std::move(fn)), m_operands(&cols...) {}
+
+template <typename Fn, typename... Cols>
+auto queryosity::column::fused<Fn, Cols...>::calculate() const -> value_type {
+  return this->compute();
+}
+
+template <typename Fn, typename... Cols>
+auto queryosity::column::fused<Fn, Cols...>::compute() const -> value_type {
+  return std::apply(
+      [this](Cols const *...cols) { return m_fn(operand(*cols)...); },
+      m_operands);
+}
+
+template <typename Fn, typename... Cols>
+auto queryosity::column::fused<Fn, Cols...>::evaluate() const
+    -> value_type const & {
+  if (this->m_epoch != this->m_cursor->epoch) {
+    this->m_value = this->compute();
+    this->m_epoch = this->m_cursor->epoch;
+  }
+  return this->m_value;
+}
+
+template <typename Fn, typename... Cols>
+template <typename Col>
+decltype(auto)
+queryosity::column::fused<Fn, Cols...>::operand(Col const &col) {
+  if constexpr (is_fused_v<Col>) {
+    return col.evaluate();
+  } else {
+    return col.value();
+  }
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+#include "column.hpp"
+#include "column_calculation.hpp"
+
+namespace queryosity {
+
+namespace column {
+
+/**
+ * @brief Logical AND of commuting decisions, evaluated in an adaptive order.
+ * @details Over the first `calibration_entries` evaluations in its slot, the
+ * pass rate and evaluation time of each decision are measured. The decisions
+ * are evaluated thereafter in ascending order of `cost / (1 - pass rate)`,
+ * such that cheap decisions that often fail are checked first.
+ */
+class intersection : public calculation<bool> {
+
+public:
+  static constexpr unsigned long long calibration_entries = 1000;
+
+public:
+  template <typename... Vals> intersection(view<Vals> const &...decs);
+  virtual ~intersection() = default;
+
+  virtual bool calculate() const final override;
+
+  /**
+   * @brief Order in which the decisions are evaluated.
+   */
+  std::vector<unsigned int> const &get_order() const { return m_order; }
+
+protected:
+  struct measurement {
+    unsigned long long evaluated;
+    unsigned long long passed;
+    double seconds;
+  };
+
+protected:
+  void reorder() const;
+
+protected:
+  std::vector<variable<bool>> m_decisions;
+  mutable std::vector<unsigned int> m_order;
+  mutable std::vector<measurement> m_measurements;
+  mutable unsigned long long m_ncalibrated;
+};
+
+} // namespace column
+
+} // namespace queryosity
+
+template <typename... Vals>
+queryosity::column::intersection::intersection(view<Vals> const &...decs)
+    : m_order(sizeof...(Vals)), m_measurements(sizeof...(Vals), measurement{}),
+      m_ncalibrated(0) {
+  (m_decisions.emplace_back(decs), ...);
+  std::iota(m_order.begin(), m_order.end(), 0);
+}
+
+inline bool queryosity::column::intersection::calculate() const {
+  if (m_ncalibrated == calibration_entries) {
+    for (auto i : m_order) {
+      if (!m_decisions[i].value())
+        return false;
+    }
+    return true;
+  }
+  bool passed = true;
+  for (auto i : m_order) {
+    auto start = std::chrono::steady_clock::now();
+    passed = m_decisions[i].value();
+    auto &msr = m_measurements[i];
+    msr.seconds += std::chrono::duration<double>(
+                       std::chrono::steady_clock::now() - start)
+                       .count();
+    msr.evaluated++;
+    if (!passed)
+      break;
+    msr.passed++;
+  }
+  // stop timing once enough entries have been measured
+  if (++m_ncalibrated == calibration_entries)
+    this->reorder();
+  return passed;
+}
+
+inline void queryosity::column::intersection::reorder() const {
+  std::vector<double> scores(m_decisions.size(),
+                             std::numeric_limits<double>::infinity());
+  for (unsigned int i = 0; i < m_decisions.size(); ++i) {
+    auto const &msr = m_measurements[i];
+    if (!msr.evaluated || msr.passed == msr.evaluated)
+      continue;
+    double cost = msr.seconds / msr.evaluated;
+    double pass = double(msr.passed) / msr.evaluated;
+    scores[i] = cost / (1.0 - pass);
+  }
+  std::stable_sort(m_order.begin(), m_order.end(),
+                   [&scores](unsigned int a, unsigned int b) {
+                     return scores[a] < scores[b];
+                   });
+}
@@ -36,11 +36,7 @@ public:
 
 protected:
   mutable T const *m_addr;
-  mutable bool m_updated;
-
-private:
-  unsigned int m_slot;
-  unsigned long long m_entry;
+  mutable unsigned long long m_epoch;
 };
 
 } // namespace column
@@ -51,20 +47,17 @@ private:
 
 template <typename T>
 queryosity::column::reader<T>::reader()
-    : m_addr(nullptr), m_updated(false), m_slot(0), m_entry(0) {}
+    : m_addr(nullptr), m_epoch(~0ULL) {}
 
 template <typename T> T const &queryosity::column::reader<T>::value() const {
-  if (!this->m_updated) {
-    m_addr = &(this->read(this->m_slot, this->m_entry));
-    m_updated = true;
+  if (m_epoch != this->m_cursor->epoch) {
+    m_addr = &(this->read(this->m_cursor->slot, this->m_cursor->entry));
+    m_epoch = this->m_cursor->epoch;
   }
   return *m_addr;
 }
 
 template <typename T>
-void queryosity::column::reader<T>::execute(unsigned int slot,
-                                            unsigned long long entry) {
-  this->m_slot = slot;
-  this->m_entry = entry;
-  this->m_updated = false;
+void queryosity::column::reader<T>::execute(unsigned int, unsigned long long) {
+  this->m_epoch = ~0ULL;
 }
\ No newline at end of file
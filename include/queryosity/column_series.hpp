@@ -1,5 +1,7 @@
 #pragma once
 
+#include <limits>
+
 #include "column.hpp"
 #include "dataflow.hpp"
 #include "lazy.hpp"
@@ -22,7 +24,14 @@ public:
   using value_type = column::value_t<typename Col::action_type>;
 
 public:
-  series(Col const &col);
+  /**
+   * @brief Constructor.
+   * @param[in] col Column whose values make up the series.
+   * @param[in] limit Maximum number of entries in the series (the dataset
+   * processing may stop early once it is reached).
+   */
+  series(Col const &col, unsigned long long limit =
+                             std::numeric_limits<unsigned long long>::max());
   ~series() = default;
 
   auto make(dataflow &df) const;
@@ -34,6 +43,7 @@ public:
 
 protected:
   Col m_column;
+  unsigned long long m_limit;
 };
 
 } // namespace column
@@ -41,17 +51,19 @@ protected:
 } // namespace queryosity
 
 template <typename Col>
-queryosity::column::series<Col>::series(Col const &col) : m_column(col){};
+queryosity::column::series<Col>::series(Col const &col,
+                                        unsigned long long limit)
+    : m_column(col), m_limit(limit){};
 
 template <typename Col>
 auto queryosity::column::series<Col>::make(dataflow &df) const {
-  return df.get(query::output<query::series<value_type>>()).fill(m_column);
+  return df.get(query::output<query::series<value_type>>(m_limit)).fill(m_column);
 }
 
 template <typename Col>
 auto queryosity::column::series<Col>::make(lazy<selection::node> &sel) const {
   auto df = sel.m_df;
-  return df->get(query::output<query::series<value_type>>())
+  return df->get(query::output<query::series<value_type>>(m_limit))
       .fill(m_column)
       .at(sel);
 }
@@ -60,7 +72,7 @@ template <typename Col>
 auto queryosity::column::series<Col>::make(varied<lazy<selection::node>> &sel)
     const -> varied<lazy<query::series<value_type>>> {
   auto df = sel.nominal().m_df;
-  return df->get(query::output<query::series<value_type>>())
+  return df->get(query::output<query::series<value_type>>(m_limit))
       .fill(m_column)
       .at(sel);
 }
\ No newline at end of file
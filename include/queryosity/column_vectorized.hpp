@@ -0,0 +1,231 @@
+#pragma once
+
+#include <memory>
+#include <tuple>
+#include <valarray>
+#include <vector>
+
+#include "column.hpp"
+#include "column_calculation.hpp"
+#include "column_evaluator.hpp"
+
+namespace queryosity {
+
+namespace column {
+
+/**
+ * @brief Nominal and variations of a column packed into contiguous lanes.
+ * @tparam Val Column value type.
+ * @details The first lane holds the nominal value, and the rest hold the
+ * values of each variation.
+ */
+template <typename Val>
+class vectorized : public calculation<std::valarray<Val>> {
+
+public:
+  vectorized() = default;
+  virtual ~vectorized() = default;
+
+  void set_arguments(std::vector<view<Val> const *> const &lanes);
+
+  virtual std::valarray<Val> calculate() const final override;
+  virtual void calculate_into(std::valarray<Val> &values) const final override;
+
+protected:
+  std::vector<view<Val> const *> m_lanes;
+};
+
+/**
+ * @brief A single lane of a vectorized column.
+ * @tparam Val Column value type.
+ */
+template <typename Val> class lane : public valued<Val> {
+
+public:
+  lane(valued<std::valarray<Val>> const &lanes, unsigned int index);
+  virtual ~lane() = default;
+
+  virtual Val const &value() const final override;
+
+  valued<std::valarray<Val>> const *get_lanes() const { return m_lanes; }
+  unsigned int get_index() const { return m_index; }
+
+protected:
+  valued<std::valarray<Val>> const *m_lanes;
+  unsigned int m_index;
+};
+
+/**
+ * @brief Column definition evaluated across all lanes of its inputs at once.
+ * @tparam Def Column definition type.
+ * @details A single instance of the definition is evaluated once per lane,
+ * with each of its input columns pointed to the corresponding lane (nominal
+ * inputs are broadcast to all lanes).
+ */
+template <typename Def>
+class lanewise : public calculation<std::valarray<value_t<Def>>> {
+
+  // the single instance is evaluated once per lane, not executed per entry
+  static_assert(!overrides_execute_v<Def>,
+                "a definition that overrides execute() cannot be vectorized");
+
+public:
+  template <typename Val> class argument;
+
+public:
+  lanewise();
+  virtual ~lanewise() = default;
+
+  template <typename... Cols>
+  void set_arguments(evaluator<Def> const &calc,
+                     std::vector<Cols const *> const &...lanes);
+
+  virtual std::valarray<value_t<Def>> calculate() const final override;
+  virtual void
+  calculate_into(std::valarray<value_t<Def>> &values) const final override;
+
+  virtual void initialize(unsigned int slot, unsigned long long begin,
+                          unsigned long long end) final override;
+  virtual void finalize(unsigned int slot) final override;
+
+protected:
+  std::unique_ptr<Def> m_definition;
+  std::vector<std::unique_ptr<column::node>> m_arguments;
+  unsigned int m_nlanes;
+  mutable unsigned int m_lane;
+};
+
+/**
+ * @brief Input column of a lanewise definition at its current lane.
+ * @tparam Val Column value type.
+ */
+template <typename Def>
+template <typename Val>
+class lanewise<Def>::argument : public valued<Val> {
+
+public:
+  argument(std::vector<view<Val> const *> const &lanes,
+           unsigned int const &lane);
+  virtual ~argument() = default;
+
+  virtual Val const &value() const final override;
+
+protected:
+  std::vector<view<Val> const *> m_lanes;
+  // lanes packed in a single vectorized column, if any
+  valued<std::valarray<Val>> const *m_packed;
+  std::vector<unsigned int> m_indices;
+  unsigned int const &m_lane;
+};
+
+} // namespace column
+
+} // namespace queryosity
+
+template <typename Val>
+void queryosity::column::vectorized<Val>::set_arguments(
+    std::vector<view<Val> const *> const &lanes) {
+  m_lanes = lanes;
+}
+
+template <typename Val>
+std::valarray<Val> queryosity::column::vectorized<Val>::calculate() const {
+  std::valarray<Val> values;
+  this->calculate_into(values);
+  return values;
+}
+
+template <typename Val>
+void queryosity::column::vectorized<Val>::calculate_into(
+    std::valarray<Val> &values) const {
+  if (values.size() != m_lanes.size())
+    values.resize(m_lanes.size());
+  for (size_t i = 0; i < m_lanes.size(); ++i) {
+    values[i] = m_lanes[i]->value();
+  }
+}
+
+template <typename Val>
+queryosity::column::lane<Val>::lane(valued<std::valarray<Val>> const &lanes,
+                                    unsigned int index)
+    : m_lanes(&lanes), m_index(index) {}
+
+template <typename Val>
+Val const &queryosity::column::lane<Val>::value() const {
+  return m_lanes->value()[m_index];
+}
+
+template <typename Def>
+queryosity::column::lanewise<Def>::lanewise() : m_nlanes(0), m_lane(0) {}
+
+template <typename Def>
+template <typename... Cols>
+void queryosity::column::lanewise<Def>::set_arguments(
+    evaluator<Def> const &calc, std::vector<Cols const *> const &...lanes) {
+  m_nlanes = std::get<0>(std::forward_as_tuple(lanes...)).size();
+  auto args = std::make_tuple(std::make_unique<argument<value_t<Cols>>>(
+      std::vector<view<value_t<Cols>> const *>(lanes.begin(), lanes.end()),
+      m_lane)...);
+  m_definition = std::apply(
+      [&calc](auto const &...args) { return calc.evaluate(*args...); }, args);
+  std::apply(
+      [this](auto &...args) { (m_arguments.push_back(std::move(args)), ...); },
+      args);
+}
+
+template <typename Def>
+std::valarray<queryosity::column::value_t<Def>>
+queryosity::column::lanewise<Def>::calculate() const {
+  std::valarray<value_t<Def>> values;
+  this->calculate_into(values);
+  return values;
+}
+
+template <typename Def>
+void queryosity::column::lanewise<Def>::calculate_into(
+    std::valarray<value_t<Def>> &values) const {
+  if (values.size() != m_nlanes)
+    values.resize(m_nlanes);
+  for (m_lane = 0; m_lane < m_nlanes; ++m_lane) {
+    m_definition->calculate_into(values[m_lane]);
+  }
+}
+
+template <typename Def>
+void queryosity::column::lanewise<Def>::initialize(unsigned int slot,
+                                                   unsigned long long begin,
+                                                   unsigned long long end) {
+  calculation<std::valarray<value_t<Def>>>::initialize(slot, begin, end);
+  m_definition->initialize(slot, begin, end);
+}
+
+template <typename Def>
+void queryosity::column::lanewise<Def>::finalize(unsigned int slot) {
+  calculation<std::valarray<value_t<Def>>>::finalize(slot);
+  m_definition->finalize(slot);
+}
+
+template <typename Def>
+template <typename Val>
+queryosity::column::lanewise<Def>::argument<Val>::argument(
+    std::vector<view<Val> const *> const &lanes, unsigned int const &lane)
+    : m_lanes(lanes), m_packed(nullptr), m_lane(lane) {
+  // index straight into the packed values if all lanes are from one column
+  for (auto const &col : m_lanes) {
+    auto lns = dynamic_cast<column::lane<Val> const *>(col);
+    if (!lns || (m_packed && lns->get_lanes() != m_packed)) {
+      m_packed = nullptr;
+      m_indices.clear();
+      break;
+    }
+    m_packed = lns->get_lanes();
+    m_indices.push_back(lns->get_index());
+  }
+}
+
+template <typename Def>
+template <typename Val>
+Val const &queryosity::column::lanewise<Def>::argument<Val>::value() const {
+  return m_packed ? m_packed->value()[m_indices[m_lane]]
+                  : m_lanes[m_lane]->value();
+}
@@ -1,9 +1,16 @@
 #pragma once
 
+#include <atomic>
+#include <functional>
+#include <future>
+#include <map>
 #include <memory>
+#include <stdexcept>
 #include <set>
 #include <string>
+#include <tuple>
 #include <type_traits>
+#include <typeindex>
 #include <utility>
 #include <vector>
 
@@ -46,24 +53,29 @@ public:
    * @brief Default constructor.
    */
   dataflow();
-  ~dataflow() = default;
-
-  template <typename Kwd> dataflow(Kwd &&kwarg);
-  template <typename Kwd1, typename Kwd2>
-  dataflow(Kwd1 &&kwarg1, Kwd2 &&kwarg2);
+  ~dataflow();
 
   /**
-   * @brief Constructor with (up to) three keyword arguments.
-   * @details Each keyword argument should be one of the following:
+   * @brief Constructor with keyword arguments.
+   * @details Each keyword argument should be one of the following (and
+   * given at most once):
    *
    *  - `queryosity::multithread::enable(unsigned int)`
    *  - `queryosity::multithread::disable()`
+   *  - `queryosity::multiprocess::enable(unsigned int)`
    *  - `queryosity::dataset::head(unsigned int)`
+   *  - `queryosity::dataset::offset(unsigned long long)`
+   *  - `queryosity::dataset::ranges(std::vector<std::pair<unsigned long long,
+   *    unsigned long long>>)`
    *  - `queryosity::dataset::weight(float)`
+   *  - `queryosity::dataset::granularity(unsigned long long)`
+   *  - `queryosity::dataset::sample(double, unsigned long long)`
+   *  - `queryosity::dataset::budget(std::chrono::duration)`
+   *  - `queryosity::dataset::window(unsigned long long | std::chrono::duration,
+   *    bool)`, or `(length, slide)` of either for sliding windows
    *
    */
-  template <typename Kwd1, typename Kwd2, typename Kwd3>
-  dataflow(Kwd1 &&kwarg1, Kwd2 &&kwarg2, Kwd3 &&kwarg3);
+  template <typename... Kwds> dataflow(Kwds &&...kwargs);
 
   dataflow(dataflow const &) = delete;
   dataflow &operator=(dataflow const &) = delete;
@@ -117,6 +129,18 @@ public:
   template <typename Val>
   auto define(column::constant<Val> const &cnst) -> lazy<column::valued<Val>>;
 
+  /**
+   * @brief Define the intersection of commuting cut decisions.
+   * @tparam Cols Input column types.
+   * @param[in] conj Input columns whose values are AND-ed together.
+   * @return Lazy boolean column.
+   * @details The order in which the decisions are evaluated is adapted to
+   * their measured pass rates and costs (see `column::intersection`).
+   */
+  template <typename... Cols>
+  auto define(column::conjunction<Cols...> const &conj)
+      -> lazy<column::intersection>;
+
   /**
    * @brief Define a column using an expression.
    * @tparam Fn Callable type.
@@ -283,7 +307,8 @@ public:
   vary(column::expression<Fn> const &expr,
        std::map<std::string,
                 typename column::expression<Fn>::function_type> const &vars)
-      -> varied<todo<column::evaluator<column::equation_t<Fn>>>>;
+      -> varied<todo<column::evaluator<column::equation_t<
+          typename column::expression<Fn>::function_type>>>>;
 
   /**
    * @brief Vary a column definition.
@@ -309,6 +334,49 @@ public:
             std::map<std::string, column::variation<column::value_t<Col>>> const
                 &vars) -> varied<lazy<column::valued<column::value_t<Col>>>>;
 
+  /**
+   * @brief Vectorize a varied column.
+   * @tparam Col Column type.
+   * @param[in] col Varied lazy column.
+   * @return Varied lazy column whose nominal and variations are lanes of a
+   * single vectorized column.
+   * @details Columns defined out of vectorized inputs are evaluated across all
+   * of their lanes at once by a single definition instance, instead of by one
+   * instance per variation.
+   */
+  template <typename Col>
+  auto vectorize(varied<lazy<Col>> const &col)
+      -> varied<lazy<column::lane<column::value_t<Col>>>>;
+
+  /**
+   * @brief Process the dataset in the background.
+   * @return Future that is ready once all booked queries have been performed.
+   * @details The analysis is only started once, until more queries are
+   * booked: subsequent calls return the future of the same analysis.
+   * @attention No actions should be booked while the analysis is in progress.
+   * Not supported with multiple processes (`std::logic_error` is thrown).
+   */
+  std::shared_future<void> analyze_async();
+
+  /**
+   * @brief Cancel the analysis in progress.
+   * @details Each thread stops once it has finished processing its current
+   * part of the dataset, and the analysis throws `std::runtime_error` to
+   * whoever waits on it. The results of the queries that were being performed
+   * are left incomplete.
+   */
+  void cancel();
+
+  /**
+   * @brief Set the function to be called at the end of each processing window
+   * (see `dataset::window`).
+   * @param[in] callback Function called once the results of the window have
+   * been copied, e.g. to retrieve them with `lazy::snapshot()`. The threads
+   * resume processing in the meantime; callbacks are never called
+   * concurrently.
+   */
+  void on_window(std::function<void()> callback);
+
   /* "public" API for Python layer */
 
   template <typename To, typename Col>
@@ -318,6 +386,9 @@ public:
   template <typename Val>
   auto _assign(Val const &val) -> lazy<column::valued<Val>>;
 
+  template <typename... Cols>
+  auto _intersect(lazy<Cols> const &...decs) -> lazy<column::intersection>;
+
   template <typename Col>
   auto _cut(lazy<Col> const &column) -> lazy<selection::node>;
 
@@ -360,17 +431,35 @@ public:
 protected:
   template <typename Kwd> void accept_kwarg(Kwd &&kwarg);
 
+  template <typename Kwd, typename... Kwds>
+  static constexpr bool is_unique_v = (std::is_same_v<Kwd, Kwds> + ...) == 1;
+
   void analyze();
   void reset();
+  void process();
 
   template <typename DS, typename Val>
-  auto _read(dataset::reader<DS> &ds,
-             const std::string &name) -> lazy<read_column_t<DS, Val>>;
+  auto _read(dataset::reader<DS> &ds, const std::string &name,
+             bool deduplicate = true) -> lazy<read_column_t<DS, Val>>;
 
   template <typename Def, typename... Cols>
   auto _evaluate(todo<column::evaluator<Def>> const &calc,
                  lazy<Cols> const &...columns) -> lazy<Def>;
 
+  template <typename Fn, typename... Cols>
+  auto _fuse(Fn const &fn, lazy<Cols> const &...columns)
+      -> lazy<column::fused<Fn, Cols...>>;
+
+  template <typename Def, typename... Nodes>
+  auto _evaluate_lanes(todo<column::evaluator<Def>> const &calc,
+                       Nodes const &...columns)
+      -> varied<lazy<column::lane<column::value_t<Def>>>>;
+
+  template <typename Lns>
+  auto _index_lanes(lazy<Lns> const &lanes,
+                    std::vector<std::string> const &lane_names)
+      -> varied<lazy<column::lane<typename column::value_t<Lns>::value_type>>>;
+
   template <typename Sel, typename Col>
   auto _apply(lazy<Col> const &col) -> lazy<selection::node>;
 
@@ -390,6 +479,15 @@ protected:
   auto _book(todo<query::booker<Qry>> const &bkr, lazy<Sels> const &...sels)
       -> std::array<lazy<Qry>, sizeof...(Sels)>;
 
+  template <typename Qry>
+  auto _book_variation(todo<query::booker<Qry>> const &bkr,
+                       lazy<selection::node> const &sel,
+                       lazy<Qry> const &nom) -> lazy<Qry>;
+
+  template <typename Act, typename Make>
+  auto _deduplicate(std::vector<void const *> const &inputs,
+                    const std::string &name, Make make) -> lazy<Act>;
+
   template <typename Syst, typename Val>
   void _vary(Syst &syst, const std::string &name,
              column::constant<Val> const &cnst);
@@ -406,11 +504,25 @@ protected:
   dataset::processor m_processor;
   dataset::weight m_weight;
   long long m_nrows;
+  unsigned long long m_offset;
+  dataset::partition_t m_ranges;
+  unsigned long long m_granularity;
+  dataset::sample m_sample;
+  dataset::budget m_budget;
+  dataset::window m_window;
+  std::function<void()> m_on_window;
 
   std::vector<std::unique_ptr<dataset::source>> m_sources;
   std::vector<unsigned int> m_dslots;
 
+  // identical actions: (type, inputs, name) -> instantiated slots
+  std::map<std::tuple<std::type_index, std::vector<void const *>, std::string>,
+           std::vector<action *>>
+      m_actions;
+
   mutable bool m_analyzed;
+  std::shared_future<void> m_analysis;
+  std::shared_ptr<std::atomic<bool>> m_cancelled;
 };
 
 class dataflow::node {
@@ -453,6 +565,7 @@ protected:
 #include "lazy_varied.hpp"
 #include "todo.hpp"
 
+#include "column_conjunction.hpp"
 #include "column_constant.hpp"
 #include "column_expression.hpp"
 #include "column_nominal.hpp"
@@ -463,47 +576,54 @@ protected:
 
 inline queryosity::dataflow::dataflow()
     : m_processor(multithread::disable()), m_weight(1.0), m_nrows(-1),
-      m_analyzed(false) {}
+      m_offset(0), m_granularity(0), m_sample(1.0), m_budget(), m_analyzed(false),
+      m_cancelled(std::make_shared<std::atomic<bool>>(false)) {}
 
-template <typename Kwd>
-queryosity::dataflow::dataflow(Kwd &&kwarg) : dataflow() {
-  this->accept_kwarg(std::forward<Kwd>(kwarg));
-}
-
-template <typename Kwd1, typename Kwd2>
-queryosity::dataflow::dataflow(Kwd1 &&kwarg1, Kwd2 &&kwarg2) : dataflow() {
-  static_assert(!std::is_same_v<Kwd1, Kwd2>,
-                "each keyword argument must be unique");
-  this->accept_kwarg(std::forward<Kwd1>(kwarg1));
-  this->accept_kwarg(std::forward<Kwd2>(kwarg2));
+inline queryosity::dataflow::~dataflow() {
+  // do not pull the dataflow out from under its analysis
+  if (m_analysis.valid())
+    m_analysis.wait();
 }
 
-template <typename Kwd1, typename Kwd2, typename Kwd3>
-queryosity::dataflow::dataflow(Kwd1 &&kwarg1, Kwd2 &&kwarg2, Kwd3 &&kwarg3)
-    : dataflow() {
-  static_assert(!std::is_same_v<Kwd1, Kwd2>,
+template <typename... Kwds>
+queryosity::dataflow::dataflow(Kwds &&...kwargs) : dataflow() {
+  static_assert((is_unique_v<Kwds, Kwds...> && ...),
                 "each keyword argument must be unique");
-  static_assert(!std::is_same_v<Kwd1, Kwd3>,
-                "each keyword argument must be unique");
-  static_assert(!std::is_same_v<Kwd2, Kwd3>,
-                "each keyword argument must be unique");
-  this->accept_kwarg(std::forward<Kwd1>(kwarg1));
-  this->accept_kwarg(std::forward<Kwd2>(kwarg2));
-  this->accept_kwarg(std::forward<Kwd3>(kwarg3));
+  (this->accept_kwarg(std::forward<Kwds>(kwargs)), ...);
 }
 
 template <typename Kwd> void queryosity::dataflow::accept_kwarg(Kwd &&kwarg) {
   constexpr bool is_mt_v = std::is_same_v<Kwd, dataset::processor>;
   constexpr bool is_weight_v = std::is_same_v<Kwd, dataset::weight>;
   constexpr bool is_nrows_v = std::is_same_v<Kwd, dataset::head>;
+  constexpr bool is_offset_v = std::is_same_v<Kwd, dataset::offset>;
+  constexpr bool is_ranges_v = std::is_same_v<Kwd, dataset::ranges>;
+  constexpr bool is_granularity_v = std::is_same_v<Kwd, dataset::granularity>;
+  constexpr bool is_sample_v = std::is_same_v<Kwd, dataset::sample>;
+  constexpr bool is_budget_v = std::is_same_v<Kwd, dataset::budget>;
+  constexpr bool is_window_v = std::is_same_v<Kwd, dataset::window>;
   if constexpr (is_mt_v) {
     m_processor = std::forward<Kwd>(kwarg);
   } else if constexpr (is_weight_v) {
     m_weight = std::forward<Kwd>(kwarg);
   } else if constexpr (is_nrows_v) {
     m_nrows = std::forward<Kwd>(kwarg);
+  } else if constexpr (is_offset_v) {
+    m_offset = std::forward<Kwd>(kwarg);
+  } else if constexpr (is_ranges_v) {
+    m_ranges = std::forward<Kwd>(kwarg);
+  } else if constexpr (is_granularity_v) {
+    m_granularity = std::forward<Kwd>(kwarg);
+  } else if constexpr (is_sample_v) {
+    m_sample = std::forward<Kwd>(kwarg);
+  } else if constexpr (is_budget_v) {
+    m_budget = std::forward<Kwd>(kwarg);
+  } else if constexpr (is_window_v) {
+    m_window = std::forward<Kwd>(kwarg);
   } else {
-    static_assert(is_mt_v || is_weight_v || is_nrows_v,
+    static_assert(is_mt_v || is_weight_v || is_nrows_v || is_offset_v ||
+                      is_ranges_v || is_granularity_v || is_sample_v ||
+                      is_budget_v || is_window_v,
                   "unrecognized keyword argument");
   }
 }
@@ -541,6 +661,12 @@ auto queryosity::dataflow::define(column::constant<Val> const &cnst)
   return cnst._assign(*this);
 }
 
+template <typename... Cols>
+auto queryosity::dataflow::define(column::conjunction<Cols...> const &conj)
+    -> lazy<column::intersection> {
+  return conj._intersect(*this);
+}
+
 template <typename Fn>
 auto queryosity::dataflow::define(column::expression<Fn> const &expr)
     -> todo<column::evaluator<column::equation_t<Fn>>> {
@@ -570,6 +696,10 @@ auto queryosity::dataflow::filter(varied<Lzy> const &col) {
   using varied_type = varied<lazy<selection::node>>;
   varied_type syst(this->filter(col.nominal()));
   for (auto const &var_name : col.get_variation_names()) {
+    if (systematic::is_nominal(var_name, col)) {
+      syst.share_nominal(var_name);
+      continue;
+    }
     syst.set_variation(var_name, this->filter(col.variation(var_name)));
   }
   return syst;
@@ -580,6 +710,10 @@ auto queryosity::dataflow::weight(varied<Lzy> const &col) {
   using varied_type = varied<lazy<selection::node>>;
   varied_type syst(this->weight(col.nominal()));
   for (auto const &var_name : col.get_variation_names()) {
+    if (systematic::is_nominal(var_name, col)) {
+      syst.share_nominal(var_name);
+      continue;
+    }
     syst.set_variation(var_name, this->weight(col.variation(var_name)));
   }
   return syst;
@@ -651,14 +785,97 @@ template <typename Def, typename... Cols>
 auto queryosity::dataflow::_evaluate(todo<column::evaluator<Def>> const &calc,
                                      lazy<Cols> const &...columns)
     -> lazy<Def> {
-  auto act = ensemble::invoke(
-      [](dataset::player *plyr, column::evaluator<Def> const *calc,
-         Cols const *...cols) {
-        return plyr->template evaluate(*calc, *cols...);
-      },
-      m_processor.get_slots(), calc.get_slots(), columns.get_slots()...);
-  auto lzy = lazy<Def>(*this, act);
-  return lzy;
+  auto evaluate = [this, &calc, &columns...]() {
+    auto act = ensemble::invoke(
+        [](dataset::player *plyr, column::evaluator<Def> const *calc,
+           Cols const *...cols) {
+          return plyr->template evaluate(*calc, *cols...);
+        },
+        m_processor.get_slots(), calc.get_slots(), columns.get_slots()...);
+    return lazy<Def>(*this, act);
+  };
+  // the same callable evaluated with the same inputs is the same column
+  if constexpr (column::is_stateless_equation_v<Def>) {
+    return this->_deduplicate<Def>({columns.get_slot(0)...}, "", evaluate);
+  } else {
+    return evaluate();
+  }
+}
+
+template <typename Fn, typename... Cols>
+auto queryosity::dataflow::_fuse(Fn const &fn, lazy<Cols> const &...columns)
+    -> lazy<column::fused<Fn, Cols...>> {
+  auto fuse = [this, &fn, &columns...]() {
+    auto act = ensemble::invoke(
+        [&fn](dataset::player *plyr, Cols const *...cols) {
+          return plyr->fuse(fn, *cols...);
+        },
+        m_processor.get_slots(), columns.get_slots()...);
+    return lazy<column::fused<Fn, Cols...>>(*this, act);
+  };
+  if constexpr (std::is_empty_v<Fn>) {
+    return this->_deduplicate<column::fused<Fn, Cols...>>(
+        {columns.get_slot(0)...}, "", fuse);
+  } else {
+    return fuse();
+  }
+}
+
+template <typename Def, typename... Nodes>
+auto queryosity::dataflow::_evaluate_lanes(
+    todo<column::evaluator<Def>> const &calc, Nodes const &...columns)
+    -> varied<lazy<column::lane<column::value_t<Def>>>> {
+  // variations under which the column remains nominal need no lane
+  std::vector<std::string> lane_names;
+  auto var_names = systematic::get_variation_names(columns...);
+  for (auto const &var_name : var_names) {
+    if (!systematic::is_nominal(var_name, columns...))
+      lane_names.push_back(var_name);
+  }
+
+  auto lanes_of = [&lane_names](auto const &col, unsigned int islot) {
+    using action_type =
+        typename std::decay_t<decltype(col.nominal())>::action_type;
+    std::vector<action_type const *> lanes{col.nominal().get_slot(islot)};
+    for (auto const &var_name : lane_names) {
+      lanes.push_back(col.variation(var_name).get_slot(islot));
+    }
+    return lanes;
+  };
+
+  std::vector<column::lanewise<Def> *> act;
+  for (unsigned int islot = 0; islot < m_processor.size(); ++islot) {
+    act.push_back(m_processor.get_slot(islot)->evaluate_lanes(
+        *calc.get_slot(islot), lanes_of(columns, islot)...));
+  }
+
+  auto syst = this->_index_lanes(lazy<column::lanewise<Def>>(*this, act),
+                                 lane_names);
+  for (auto const &var_name : var_names) {
+    if (!syst.has_variation(var_name))
+      syst.share_nominal(var_name);
+  }
+  return syst;
+}
+
+template <typename Lns>
+auto queryosity::dataflow::_index_lanes(
+    lazy<Lns> const &lanes, std::vector<std::string> const &lane_names)
+    -> varied<lazy<column::lane<typename column::value_t<Lns>::value_type>>> {
+  using value_type = typename column::value_t<Lns>::value_type;
+  auto lane_at = [this, &lanes](unsigned int index) {
+    return lazy<column::lane<value_type>>(
+        *this, ensemble::invoke(
+                   [index](dataset::player *plyr, Lns const *lns) {
+                     return plyr->index_lane(*lns, index);
+                   },
+                   m_processor.get_slots(), lanes.get_slots()));
+  };
+  varied<lazy<column::lane<value_type>>> syst(lane_at(0));
+  for (unsigned int ilane = 0; ilane < lane_names.size(); ++ilane) {
+    syst.set_variation(lane_names[ilane], lane_at(ilane + 1));
+  }
+  return syst;
 }
 
 template <typename Sel, typename Def, typename... Cols>
@@ -694,15 +911,72 @@ auto queryosity::dataflow::_book(todo<query::booker<Qry>> const &bkr,
   return std::array<lazy<Qry>, sizeof...(Sels)>{this->_book(bkr, sels)...};
 }
 
+template <typename Qry>
+auto queryosity::dataflow::_book_variation(todo<query::booker<Qry>> const &bkr,
+                                           lazy<selection::node> const &sel,
+                                           lazy<Qry> const &nom) -> lazy<Qry> {
+  // same columns, different selection: count alongside the nominal
+  auto var = this->_book(bkr, sel);
+  dataflow::node::invoke([](Qry *nom, Qry *var) { nom->add_variation(*var); },
+                         nom, var);
+  return var;
+}
+
 inline void queryosity::dataflow::analyze() {
+  // join the analysis in progress (if any)
+  if (m_analysis.valid()) {
+    auto analysis = std::move(m_analysis);
+    m_analysis = std::shared_future<void>();
+    analysis.get();
+    m_analyzed = true;
+  }
   if (m_analyzed)
     return;
 
-  m_processor.process(m_sources, m_weight, m_nrows);
+  m_cancelled->store(false);
+  this->process();
   m_analyzed = true;
 }
 
-inline void queryosity::dataflow::reset() { m_analyzed = false; }
+inline std::shared_future<void> queryosity::dataflow::analyze_async() {
+  if (m_analysis.valid())
+    return m_analysis;
+  if (m_analyzed) {
+    std::promise<void> analyzed;
+    analyzed.set_value();
+    return analyzed.get_future().share();
+  }
+  // (forking off of a background thread is unsafe)
+  if (m_processor.processes() > 1)
+    throw std::logic_error(
+        "asynchronous analysis is not supported with multiple processes");
+  m_cancelled->store(false);
+  m_analysis =
+      std::async(std::launch::async, [this]() { this->process(); }).share();
+  return m_analysis;
+}
+
+inline void queryosity::dataflow::cancel() { m_cancelled->store(true); }
+
+inline void queryosity::dataflow::on_window(std::function<void()> callback) {
+  m_on_window = std::move(callback);
+}
+
+inline void queryosity::dataflow::process() {
+  m_processor.process(m_sources, m_weight, m_ranges, m_offset, m_nrows,
+                      m_granularity, m_sample, m_budget, m_window,
+                      m_on_window, *m_cancelled);
+  if (m_cancelled->load())
+    throw std::runtime_error("dataflow analysis was cancelled");
+}
+
+inline void queryosity::dataflow::reset() {
+  // a finished analysis does not cover the queries booked since
+  if (m_analysis.valid())
+    m_analysis.wait();
+  m_analysis = std::shared_future<void>();
+  m_analyzed = false;
+}
 
 template <typename Val>
 auto queryosity::dataflow::vary(column::constant<Val> const &cnst,
@@ -721,10 +995,13 @@ template <typename Fn>
 auto queryosity::dataflow::vary(
     column::expression<Fn> const &expr,
     std::map<std::string, typename column::expression<Fn>::function_type> const
-        &vars) -> varied<todo<column::evaluator<column::equation_t<Fn>>>> {
-  auto nom = this->_equate(expr);
-  using varied_type = varied<decltype(nom)>;
+        &vars)
+    -> varied<todo<column::evaluator<
+        column::equation_t<typename column::expression<Fn>::function_type>>>> {
+  // nominal and variations must share one (type-erased) callable type
   using function_type = typename column::expression<Fn>::function_type;
+  auto nom = this->_equate(column::expression<function_type>(expr));
+  using varied_type = varied<decltype(nom)>;
   varied_type syst(std::move(nom));
   for (auto const &var : vars) {
     this->_vary(syst, var.first, column::expression<function_type>(var.second));
@@ -759,13 +1036,49 @@ auto queryosity::dataflow::vary(
   return sys;
 }
 
+template <typename Col>
+auto queryosity::dataflow::vectorize(varied<lazy<Col>> const &col)
+    -> varied<lazy<column::lane<column::value_t<Col>>>> {
+  std::vector<std::string> lane_names;
+  for (auto const &var_name : col.get_variation_names()) {
+    if (!systematic::is_nominal(var_name, col))
+      lane_names.push_back(var_name);
+  }
+
+  std::vector<column::vectorized<column::value_t<Col>> *> act;
+  for (unsigned int islot = 0; islot < m_processor.size(); ++islot) {
+    std::vector<Col const *> lanes{col.nominal().get_slot(islot)};
+    for (auto const &var_name : lane_names) {
+      lanes.push_back(col.variation(var_name).get_slot(islot));
+    }
+    act.push_back(m_processor.get_slot(islot)->vectorize(lanes));
+  }
+
+  auto syst = this->_index_lanes(
+      lazy<column::vectorized<column::value_t<Col>>>(*this, act), lane_names);
+  for (auto const &var_name : col.get_variation_names()) {
+    if (!syst.has_variation(var_name))
+      syst.share_nominal(var_name);
+  }
+  return syst;
+}
+
 template <typename DS, typename Val>
 auto queryosity::dataflow::_read(dataset::reader<DS> &ds,
-                                 const std::string &column_name)
+                                 const std::string &column_name,
+                                 bool deduplicate)
     -> lazy<read_column_t<DS, Val>> {
-  auto act = m_processor.read<DS, Val>(ds, column_name);
-  auto lzy = lazy<read_column_t<DS, Val>>(*this, act);
-  return lzy;
+  // a varied read must not be shared, as it is told about its variation
+  if (!deduplicate) {
+    auto act = m_processor.read<DS, Val>(ds, column_name);
+    return lazy<read_column_t<DS, Val>>(*this, act);
+  }
+  // each column of a dataset is only read out once
+  return this->_deduplicate<read_column_t<DS, Val>>(
+      {&ds}, column_name, [this, &ds, &column_name]() {
+        auto act = m_processor.read<DS, Val>(ds, column_name);
+        return lazy<read_column_t<DS, Val>>(*this, act);
+      });
 }
 
 template <typename Val>
@@ -778,6 +1091,18 @@ auto queryosity::dataflow::_assign(Val const &val)
   return lzy;
 }
 
+template <typename... Cols>
+auto queryosity::dataflow::_intersect(lazy<Cols> const &...decs)
+    -> lazy<column::intersection> {
+  auto act = ensemble::invoke(
+      [](dataset::player *plyr, Cols const *...decs) {
+        return plyr->intersect(*decs...);
+      },
+      m_processor.get_slots(), decs.get_slots()...);
+  auto lzy = lazy<column::intersection>(*this, act);
+  return lzy;
+}
+
 template <typename Col>
 auto queryosity::dataflow::_cut(lazy<Col> const &col) -> lazy<selection::node> {
   return this->filter(col);
@@ -792,13 +1117,15 @@ auto queryosity::dataflow::_cut(varied<Lzy> const &col)
 template <typename To, typename Col>
 auto queryosity::dataflow::_convert(lazy<Col> const &col)
     -> lazy<column::conversion<To, column::value_t<Col>>> {
-  auto act = ensemble::invoke(
-      [](dataset::player *plyr, Col const *from) {
-        return plyr->template convert<To>(*from);
-      },
-      m_processor.get_slots(), col.get_slots());
-  auto lzy = lazy<column::conversion<To, column::value_t<Col>>>(*this, act);
-  return lzy;
+  return this->_deduplicate<column::conversion<To, column::value_t<Col>>>(
+      {col.get_slot(0)}, "", [this, &col]() {
+        auto act = ensemble::invoke(
+            [](dataset::player *plyr, Col const *from) {
+              return plyr->template convert<To>(*from);
+            },
+            m_processor.get_slots(), col.get_slots());
+        return lazy<column::conversion<To, column::value_t<Col>>>(*this, act);
+      });
 }
 
 template <typename Def>
@@ -904,6 +1231,21 @@ auto queryosity::dataflow::_apply(lazy<selection::node> const &prev,
   return lzy;
 }
 
+template <typename Act, typename Make>
+auto queryosity::dataflow::_deduplicate(std::vector<void const *> const &inputs,
+                                        const std::string &name, Make make)
+    -> lazy<Act> {
+  auto key = std::make_tuple(std::type_index(typeid(Act)), inputs, name);
+  auto found = m_actions.find(key);
+  if (found != m_actions.end()) {
+    return lazy<Act>(*this, found->second);
+  }
+  auto lzy = make();
+  m_actions.emplace(key, std::vector<action *>(lzy.get_slots().begin(),
+                                               lzy.get_slots().end()));
+  return lzy;
+}
+
 template <typename Syst, typename Val>
 void queryosity::dataflow::_vary(Syst &syst, const std::string &name,
                                  column::constant<Val> const &cnst) {
@@ -13,8 +13,9 @@ public:
   input(dataflow &df, DS &ds);
   ~input() = default;
 
-  template <typename Val> auto _read(const std::string &name) {
-    return m_df->_read<DS, Val>(*m_ds, name);
+  template <typename Val>
+  auto _read(const std::string &name, bool deduplicate = true) {
+    return m_df->_read<DS, Val>(*m_ds, name, deduplicate);
   }
 
   template <typename Val>
@@ -64,8 +65,8 @@ auto queryosity::dataflow::input<DS>::vary(
   auto nom = this->read(col);
   varied<decltype(nom)> varied_column(std::move(nom));
   for (auto const &var : vars) {
-    varied_column.set_variation(var.first,
-                                this->read(dataset::column<Val>(var.second)));
+    varied_column.set_variation(
+        var.first, this->template _read<Val>(var.second, false));
   }
   return varied_column;
 }
\ No newline at end of file
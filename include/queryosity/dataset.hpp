@@ -1,11 +1,14 @@
 #pragma once
 
+#include <algorithm>
 #include <cassert>
+#include <chrono>
 #include <iostream>
 #include <iterator>
 #include <memory>
 #include <numeric>
 #include <string>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -44,12 +47,130 @@ struct offset {
   operator unsigned long long() { return pos; }
 };
 
+/**
+ * @brief Process only the entries within a list of ranges.
+ * @details Each range is a pair of the first and last (exclusive) entries.
+ * The ranges may be given in any order; overlapping or adjacent ranges are
+ * processed as one.
+ */
+struct ranges {
+  ranges(std::vector<part_t> parts) : parts(std::move(parts)) {}
+  std::vector<part_t> parts;
+  operator std::vector<part_t>() { return parts; }
+};
+
 struct weight {
   weight(double value) : value(value) {}
   double value;
   operator double() { return value; }
 };
 
+/**
+ * @brief Regroup the dataset partition into parts of a target number of
+ * entries.
+ * @details Adjacent parts smaller than the target are merged, and parts
+ * larger than it are split if the dataset allows.
+ */
+struct granularity {
+  granularity(unsigned long long nentries) : nentries(nentries) {}
+  unsigned long long nentries;
+  operator unsigned long long() { return nentries; }
+};
+
+/**
+ * @brief Process a (reproducible) random subset of the dataset partition.
+ * @details Query results are extrapolated to the full dataset.
+ */
+struct sample {
+  sample(double fraction, unsigned long long seed = 0)
+      : fraction(fraction), seed(seed) {}
+  double fraction;
+  unsigned long long seed;
+};
+
+/**
+ * @brief Stop processing the dataset once a wall-clock time budget is spent.
+ * @details The deadline is checked in-between dataset parts, and every
+ * `player::deadline_interval` entries within them; the parts in progress are
+ * finalized as they are.
+ */
+struct budget {
+  budget() : duration(std::chrono::steady_clock::duration::max()) {}
+  template <typename Rep, typename Period>
+  budget(std::chrono::duration<Rep, Period> const &duration)
+      : duration(
+            std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                duration)) {}
+  std::chrono::steady_clock::duration duration;
+};
+
+/**
+ * @brief Process the dataset in windows, in-between which snapshots of the
+ * query results are published (see `dataflow::on_window()`).
+ * @details A window closes after (at least) a number of entries or a
+ * wall-clock duration, whichever comes first, upon the thread slots
+ * completing their parts in progress. Windows are cumulative by default, or
+ * tumbling if the queries are reset after each snapshot.
+ *
+ * Sliding windows are given by their length and slide step (both in entries,
+ * or both in wall-clock time): the queries are reset after every step, and
+ * each snapshot merges those of the latest steps spanning the length (rounded
+ * up to a whole number of steps).
+ */
+struct window {
+  window()
+      : nentries(0), duration(std::chrono::steady_clock::duration::max()),
+        tumbling(false), nsteps(1) {}
+  window(unsigned long long nentries, bool tumbling = false)
+      : nentries(nentries),
+        duration(std::chrono::steady_clock::duration::max()),
+        tumbling(tumbling), nsteps(1) {}
+  template <typename Rep, typename Period>
+  window(std::chrono::duration<Rep, Period> const &duration,
+         bool tumbling = false)
+      : nentries(0),
+        duration(
+            std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                duration)),
+        tumbling(tumbling), nsteps(1) {}
+  template <typename Int,
+            std::enable_if_t<std::is_integral_v<Int> &&
+                                 !std::is_same_v<Int, bool>,
+                             bool> = false>
+  window(unsigned long long length, Int slide)
+      : nentries(slide), duration(std::chrono::steady_clock::duration::max()),
+        tumbling(true), nsteps(count_steps(length, slide)) {}
+  template <typename Rep, typename Period, typename SlideRep,
+            typename SlidePeriod>
+  window(std::chrono::duration<Rep, Period> const &length,
+         std::chrono::duration<SlideRep, SlidePeriod> const &slide)
+      : nentries(0),
+        duration(
+            std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                slide)),
+        tumbling(true),
+        nsteps(count_steps(
+            std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                length)
+                .count(),
+            duration.count())) {}
+  bool is_enabled() const {
+    return nentries || duration != std::chrono::steady_clock::duration::max();
+  }
+  static unsigned int count_steps(unsigned long long length,
+                                  unsigned long long slide) {
+    return slide ? std::max<unsigned long long>((length + slide - 1) / slide, 1)
+                 : 1;
+  }
+  // (slide) step
+  unsigned long long nentries;
+  std::chrono::steady_clock::duration duration;
+  // reset the queries after each step
+  bool tumbling;
+  // steps merged into each snapshot
+  unsigned int nsteps;
+};
+
 } // namespace dataset
 
 } // namespace queryosity
@@ -0,0 +1,296 @@
+#pragma once
+
+#include <deque>
+#include <map>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "dataset.hpp"
+#include "dataset_reader.hpp"
+
+namespace queryosity {
+
+namespace dataset {
+
+/**
+ * @ingroup api
+ * @brief Dataset whose columns are cached in-memory once they are read.
+ * @tparam DS Concrete implementation of `queryosity::dataset::reader`.
+ * @details The first pass over each part of the dataset reads the requested
+ * columns out of the underlying dataset, capturing their values entry-by-entry
+ * into typed arrays. Any subsequent pass over the same part (e.g. after more
+ * queries have been booked) serves the columns out of memory, without
+ * initializing or executing the underlying dataset at all. The partition of
+ * the underlying dataset is also only determined once.
+ * @attention The columns of the cached dataset are captured for every entry of
+ * the part being processed, whether or not they are actually used in the
+ * entry. Only columns whose values are fully determined by their entry number
+ * should be cached.
+ * @attention With multiple processes (see `multiprocess::enable`), the
+ * columns are cached by the worker processes, which exit at the end of each
+ * analysis: every pass reads the underlying dataset anew.
+ */
+template <typename DS> class cached : public reader<cached<DS>> {
+
+public:
+  class capture;
+
+  template <typename Val> class array;
+
+public:
+  /**
+   * @brief Constructor.
+   * @param[in] args Constructor arguments of the underlying dataset.
+   */
+  template <typename... Args> cached(Args &&...args);
+  virtual ~cached() = default;
+
+  virtual void parallelize(unsigned int concurrency) final override;
+
+  virtual void initialize() final override;
+
+  /**
+   * @brief Partition of the underlying dataset.
+   * @details Determined once upon the first pass and re-used afterwards.
+   */
+  virtual std::vector<std::pair<unsigned long long, unsigned long long>>
+  partition() final override;
+
+  virtual bool is_splittable() const final override;
+
+  virtual void initialize(unsigned int slot, unsigned long long begin,
+                          unsigned long long end) final override;
+
+  virtual void execute(unsigned int slot,
+                       unsigned long long entry) final override;
+
+  virtual void finalize(unsigned int slot) final override;
+
+  virtual void finalize() final override;
+
+  /**
+   * @brief Read a cached column.
+   * @tparam Val Column value type.
+   * @param[in] slot Thread slot number.
+   * @param[in] name Column name.
+   * @return Cached column.
+   */
+  template <typename Val>
+  std::unique_ptr<array<Val>> read(unsigned int slot, const std::string &name);
+
+protected:
+  std::unique_ptr<DS> m_ds;
+  std::vector<std::pair<unsigned long long, unsigned long long>> m_partition;
+  bool m_partitioned;
+  std::vector<std::vector<capture *>> m_columns;
+  std::vector<std::vector<capture *>> m_capturing;
+};
+
+/**
+ * @brief Cached column interface towards its dataset.
+ */
+template <typename DS> class cached<DS>::capture {
+
+public:
+  capture() = default;
+  virtual ~capture() = default;
+
+  /**
+   * @brief Prepare the column to be served over a part.
+   * @param[in] begin First entry of the part.
+   * @param[in] end Last entry (exclusive) of the part.
+   * @return `true` if the values of the part are yet to be captured.
+   */
+  virtual bool prepare(unsigned long long begin, unsigned long long end) = 0;
+
+  /**
+   * @brief Capture the value of the column at an entry.
+   * @param[in] slot Thread slot number.
+   * @param[in] entry Entry being processed.
+   */
+  virtual void record(unsigned int slot, unsigned long long entry) = 0;
+};
+
+/**
+ * @brief Cached column values.
+ * @tparam Val Column value type.
+ */
+template <typename DS>
+template <typename Val>
+class cached<DS>::array : public queryosity::column::reader<Val>,
+                          public cached<DS>::capture {
+
+public:
+  // std::vector<bool> cannot return references to its elements
+  using store_type = std::conditional_t<std::is_same_v<Val, bool>,
+                                        std::deque<Val>, std::vector<Val>>;
+
+public:
+  array(std::unique_ptr<queryosity::column::reader<Val>> column);
+  virtual ~array() = default;
+
+  virtual bool prepare(unsigned long long begin,
+                       unsigned long long end) final override;
+
+  virtual void record(unsigned int slot,
+                      unsigned long long entry) final override;
+
+  virtual Val const &read(unsigned int slot,
+                          unsigned long long entry) const final override;
+
+  virtual void initialize(unsigned int slot, unsigned long long begin,
+                          unsigned long long end) final override;
+  virtual void finalize(unsigned int slot) final override;
+
+  virtual void vary(const std::string &variation_name) final override;
+
+protected:
+  std::unique_ptr<queryosity::column::reader<Val>> m_column;
+  std::map<unsigned long long, store_type> m_parts;
+  store_type *m_values;
+  unsigned long long m_begin;
+  bool m_capturing;
+};
+
+} // namespace dataset
+
+} // namespace queryosity
+
+template <typename DS>
+template <typename... Args>
+queryosity::dataset::cached<DS>::cached(Args &&...args)
+    : m_ds(std::make_unique<DS>(std::forward<Args>(args)...)),
+      m_partitioned(false) {}
+
+template <typename DS>
+void queryosity::dataset::cached<DS>::parallelize(unsigned int concurrency) {
+  static_cast<source &>(*m_ds).parallelize(concurrency);
+  m_columns.resize(concurrency);
+  m_capturing.resize(concurrency);
+}
+
+template <typename DS> void queryosity::dataset::cached<DS>::initialize() {
+  static_cast<source &>(*m_ds).initialize();
+}
+
+template <typename DS>
+std::vector<std::pair<unsigned long long, unsigned long long>>
+queryosity::dataset::cached<DS>::partition() {
+  if (!m_partitioned) {
+    m_partition = static_cast<source &>(*m_ds).partition();
+    m_partitioned = true;
+  }
+  return m_partition;
+}
+
+template <typename DS>
+bool queryosity::dataset::cached<DS>::is_splittable() const {
+  return static_cast<source const &>(*m_ds).is_splittable();
+}
+
+template <typename DS>
+void queryosity::dataset::cached<DS>::initialize(unsigned int slot,
+                                                 unsigned long long begin,
+                                                 unsigned long long end) {
+  // only the columns not yet captured over the part need to be read out
+  m_capturing[slot].clear();
+  for (auto const &col : m_columns[slot]) {
+    if (col->prepare(begin, end))
+      m_capturing[slot].push_back(col);
+  }
+  if (m_capturing[slot].size())
+    static_cast<source &>(*m_ds).initialize(slot, begin, end);
+}
+
+template <typename DS>
+void queryosity::dataset::cached<DS>::execute(unsigned int slot,
+                                              unsigned long long entry) {
+  if (!m_capturing[slot].size())
+    return;
+  static_cast<source &>(*m_ds).execute(slot, entry);
+  for (auto const &col : m_capturing[slot]) {
+    col->record(slot, entry);
+  }
+}
+
+template <typename DS>
+void queryosity::dataset::cached<DS>::finalize(unsigned int slot) {
+  if (m_capturing[slot].size())
+    static_cast<source &>(*m_ds).finalize(slot);
+}
+
+template <typename DS> void queryosity::dataset::cached<DS>::finalize() {
+  static_cast<source &>(*m_ds).finalize();
+}
+
+template <typename DS>
+template <typename Val>
+std::unique_ptr<typename queryosity::dataset::cached<DS>::template array<Val>>
+queryosity::dataset::cached<DS>::read(unsigned int slot,
+                                      const std::string &name) {
+  auto col = std::make_unique<array<Val>>(
+      m_ds->template read_column<Val>(slot, name));
+  m_columns[slot].push_back(col.get());
+  return col;
+}
+
+template <typename DS>
+template <typename Val>
+queryosity::dataset::cached<DS>::array<Val>::array(
+    std::unique_ptr<queryosity::column::reader<Val>> column)
+    : m_column(std::move(column)), m_values(nullptr), m_begin(0),
+      m_capturing(false) {}
+
+template <typename DS>
+template <typename Val>
+bool queryosity::dataset::cached<DS>::array<Val>::prepare(
+    unsigned long long begin, unsigned long long end) {
+  m_begin = begin;
+  m_values = &m_parts[begin];
+  // a part is only served once it has been fully captured (it may not have
+  // been, if e.g. its processing was cut short)
+  m_capturing = m_values->size() < end - begin;
+  if (m_capturing)
+    m_values->clear();
+  return m_capturing;
+}
+
+template <typename DS>
+template <typename Val>
+void queryosity::dataset::cached<DS>::array<Val>::record(
+    unsigned int slot, unsigned long long entry) {
+  m_values->push_back(m_column->read(slot, entry));
+}
+
+template <typename DS>
+template <typename Val>
+Val const &
+queryosity::dataset::cached<DS>::array<Val>::read(unsigned int,
+                                                 unsigned long long entry) const {
+  return (*m_values)[entry - m_begin];
+}
+
+template <typename DS>
+template <typename Val>
+void queryosity::dataset::cached<DS>::array<Val>::initialize(
+    unsigned int slot, unsigned long long begin, unsigned long long end) {
+  if (m_capturing)
+    m_column->initialize(slot, begin, end);
+}
+
+template <typename DS>
+template <typename Val>
+void queryosity::dataset::cached<DS>::array<Val>::finalize(unsigned int slot) {
+  if (m_capturing)
+    m_column->finalize(slot);
+}
+
+template <typename DS>
+template <typename Val>
+void queryosity::dataset::cached<DS>::array<Val>::vary(
+    const std::string &variation_name) {
+  m_column->vary(variation_name);
+}
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+
+#include "dataset.hpp"
+
+namespace queryosity {
+
+namespace dataset {
+
+/**
+ * @brief Synchronize the thread slots at the boundaries of processing windows.
+ * @details Each slot checks in-between its parts whether the current window is
+ * over, in which case it waits for all other slots still processing to do the
+ * same. The last slot to arrive takes the snapshot of the results (while none
+ * of them are being filled), after which all slots resume and the snapshot is
+ * published.
+ */
+class monitor {
+
+public:
+  /**
+   * @brief Constructor.
+   * @param[in] window Window configuration.
+   * @param[in] nslots Number of thread slots.
+   * @param[in] snapshot Function called at the end of each window, with all
+   * slots on hold.
+   * @param[in] publish Function called after each snapshot, with the slots
+   * resumed (one at a time).
+   */
+  monitor(dataset::window const &window, unsigned int nslots,
+          std::function<void()> snapshot, std::function<void()> publish);
+  ~monitor() = default;
+
+  /**
+   * @brief Check in a slot in-between its parts.
+   * @param[in] nentries Number of entries processed by the slot since its
+   * previous check-in.
+   */
+  void checkpoint(unsigned long long nentries);
+
+  /**
+   * @brief Check out a slot that has stopped processing.
+   */
+  void leave();
+
+  /**
+   * @brief Check in a slot in-between each part that it is handed.
+   * @param[in] next Function that assigns the next part of the slot.
+   * @return Function that does the same after checking in.
+   */
+  std::function<bool(part_t &)>
+  watch(std::function<bool(part_t &)> next);
+
+protected:
+  void release(std::unique_lock<std::mutex> &lock);
+
+protected:
+  dataset::window m_window;
+  std::function<void()> m_snapshot;
+  std::function<void()> m_publish;
+
+  std::mutex m_mutex;
+  std::mutex m_publishing;
+  std::condition_variable m_released;
+  unsigned int m_nactive;
+  unsigned int m_nwaiting;
+  unsigned long long m_generation;
+
+  unsigned long long m_nentries;
+  std::chrono::steady_clock::time_point m_start;
+  bool m_due;
+};
+
+} // namespace dataset
+
+} // namespace queryosity
+
+inline queryosity::dataset::monitor::monitor(dataset::window const &window,
+                                             unsigned int nslots,
+                                             std::function<void()> snapshot,
+                                             std::function<void()> publish)
+    : m_window(window), m_snapshot(std::move(snapshot)),
+      m_publish(std::move(publish)), m_nactive(nslots),
+      m_nwaiting(0), m_generation(0), m_nentries(0),
+      m_start(std::chrono::steady_clock::now()), m_due(false) {}
+
+inline void
+queryosity::dataset::monitor::checkpoint(unsigned long long nentries) {
+  if (!m_window.is_enabled())
+    return;
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_nentries += nentries;
+  if (!m_due)
+    m_due = (m_window.nentries && m_nentries >= m_window.nentries) ||
+            std::chrono::steady_clock::now() - m_start >= m_window.duration;
+  if (!m_due)
+    return;
+  if (++m_nwaiting == m_nactive) {
+    this->release(lock);
+    return;
+  }
+  const auto generation = m_generation;
+  m_released.wait(lock,
+                  [this, generation]() { return m_generation != generation; });
+}
+
+inline void queryosity::dataset::monitor::leave() {
+  if (!m_window.is_enabled())
+    return;
+  std::unique_lock<std::mutex> lock(m_mutex);
+  --m_nactive;
+  // the others may have only been waiting for this slot
+  if (m_nwaiting && m_nwaiting == m_nactive)
+    this->release(lock);
+}
+
+inline std::function<bool(queryosity::dataset::part_t &)>
+queryosity::dataset::monitor::watch(std::function<bool(part_t &)> next) {
+  if (!m_window.is_enabled())
+    return next;
+  return [this, next, nentries = 0ULL](part_t &part) mutable {
+    this->checkpoint(nentries);
+    if (!next(part))
+      return false;
+    nentries = part.second - part.first;
+    return true;
+  };
+}
+
+inline void
+queryosity::dataset::monitor::release(std::unique_lock<std::mutex> &lock) {
+  // (the previous snapshot may still be being published by a slot that has
+  // checked out since)
+  std::unique_lock<std::mutex> publishing(m_publishing);
+  if (m_snapshot)
+    m_snapshot();
+  m_nentries = 0;
+  m_start = std::chrono::steady_clock::now();
+  m_due = false;
+  m_nwaiting = 0;
+  ++m_generation;
+  m_released.notify_all();
+  // publish while the other slots resume
+  lock.unlock();
+  if (m_publish)
+    m_publish();
+}
@@ -1,11 +1,16 @@
 #pragma once
 
+#include <algorithm>
 #include <cassert>
+#include <cmath>
 #include <iostream>
 #include <iterator>
+#include <limits>
 #include <map>
 #include <memory>
 #include <numeric>
+#include <random>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -26,8 +31,21 @@ namespace partition {
 
 partition_t align(std::vector<partition_t> const &partitions);
 
+partition_t align(std::vector<partition_t> const &partitions,
+                  std::vector<bool> const &splittable);
+
 partition_t truncate(partition_t const &parts, long long nentries_max);
 
+partition_t skip(partition_t const &parts, unsigned long long nentries);
+
+partition_t clip(partition_t const &parts, partition_t ranges);
+
+partition_t sample(partition_t const &parts, double fraction,
+                   unsigned long long seed, bool splittable);
+
+partition_t regroup(partition_t const &parts, unsigned long long nentries,
+                    bool splittable);
+
 } // namespace partition
 
 } // namespace dataset
@@ -36,36 +54,79 @@ partition_t truncate(partition_t const &parts, long long nentries_max);
 
 inline queryosity::dataset::partition_t queryosity::dataset::partition::align(
     std::vector<partition_t> const &partitions) {
-  std::map<entry_t, unsigned int> edge_counts;
-  const unsigned int num_vectors = partitions.size();
+  return align(partitions, std::vector<bool>(partitions.size(), false));
+}
 
-  // Count appearances of each edge
-  for (auto const &vec : partitions) {
-    std::map<entry_t, bool>
-        seen_edges; // Ensure each edge is only counted once per vector
-    for (auto const &p : vec) {
-      if (seen_edges.find(p.first) == seen_edges.end()) {
-        edge_counts[p.first]++;
-        seen_edges[p.first] = true;
+inline queryosity::dataset::partition_t queryosity::dataset::partition::align(
+    std::vector<partition_t> const &partitions,
+    std::vector<bool> const &splittable) {
+  // Only the partitions with fixed boundaries need to agree on an edge,
+  // the rest can follow along any of them
+  std::vector<partition_t const *> fixed;
+  for (unsigned int i = 0; i < partitions.size(); ++i) {
+    if (!splittable[i])
+      fixed.push_back(&partitions[i]);
+  }
+
+  std::vector<entry_t> aligned_edges;
+  if (!fixed.size()) {
+    // Union of all edges
+    std::set<entry_t> edges;
+    for (auto const &vec : partitions) {
+      for (auto const &p : vec) {
+        edges.insert(p.first);
+        edges.insert(p.second);
       }
-      if (seen_edges.find(p.second) == seen_edges.end()) {
-        edge_counts[p.second]++;
-        seen_edges[p.second] = true;
+    }
+    aligned_edges.assign(edges.begin(), edges.end());
+  } else {
+    std::map<entry_t, unsigned int> edge_counts;
+    const unsigned int num_vectors = fixed.size();
+
+    // Count appearances of each edge
+    for (auto const *fixed_vec : fixed) {
+      auto const &vec = *fixed_vec;
+      std::map<entry_t, bool>
+          seen_edges; // Ensure each edge is only counted once per vector
+      for (auto const &p : vec) {
+        if (seen_edges.find(p.first) == seen_edges.end()) {
+          edge_counts[p.first]++;
+          seen_edges[p.first] = true;
+        }
+        if (seen_edges.find(p.second) == seen_edges.end()) {
+          edge_counts[p.second]++;
+          seen_edges[p.second] = true;
+        }
+      }
+    }
+
+    // Filter edges that appear in all vectors
+    for (auto const &pair : edge_counts) {
+      if (pair.second == num_vectors) {
+        aligned_edges.push_back(pair.first);
       }
     }
   }
 
-  // Filter edges that appear in all vectors
-  std::vector<entry_t> aligned_edges;
-  for (auto const &pair : edge_counts) {
-    if (pair.second == num_vectors) {
-      aligned_edges.push_back(pair.first);
+  // Clamp to the entries that every source (splittable or not) has
+  entry_t extent = std::numeric_limits<entry_t>::max();
+  for (auto const &vec : partitions) {
+    entry_t last = 0;
+    for (auto const &p : vec) {
+      last = std::max(last, p.second);
     }
+    extent = std::min(extent, last);
+  }
+  if (aligned_edges.size() && aligned_edges.back() > extent) {
+    while (aligned_edges.size() && aligned_edges.back() >= extent) {
+      aligned_edges.pop_back();
+    }
+    aligned_edges.push_back(extent);
   }
 
   // Create aligned vector of pairs
   std::vector<std::pair<entry_t, entry_t>> aligned_ranges;
-  for (size_t i = 0; i < aligned_edges.size() - 1; ++i) {
+  for (size_t i = 0; i + 1 < aligned_edges.size(); ++i) {
     aligned_ranges.emplace_back(aligned_edges[i], aligned_edges[i + 1]);
   }
 
@@ -91,4 +152,140 @@ queryosity::dataset::partition::truncate(
   }
 
   return parts_truncated;
-}
\ No newline at end of file
+}
+
+inline queryosity::dataset::partition_t
+queryosity::dataset::partition::skip(
+    queryosity::dataset::partition_t const &parts, unsigned long long nentries) {
+  partition_t parts_skipped;
+
+  for (auto const &part : parts) {
+    const auto nentries_part = part.second - part.first;
+    if (nentries >= nentries_part) {
+      nentries -= nentries_part;
+      continue;
+    }
+    parts_skipped.emplace_back(part.first + nentries, part.second);
+    nentries = 0;
+  }
+
+  return parts_skipped;
+}
+
+inline queryosity::dataset::partition_t
+queryosity::dataset::partition::clip(
+    queryosity::dataset::partition_t const &parts, partition_t ranges) {
+  if (!ranges.size())
+    return parts;
+
+  // parts are in order, so the ranges need to be too
+  std::sort(ranges.begin(), ranges.end());
+
+  // overlapping or adjacent ranges are merged into one
+  partition_t ranges_merged;
+  for (auto const &rng : ranges) {
+    if (rng.first >= rng.second)
+      continue;
+    if (ranges_merged.size() && rng.first <= ranges_merged.back().second) {
+      ranges_merged.back().second =
+          std::max(ranges_merged.back().second, rng.second);
+    } else {
+      ranges_merged.push_back(rng);
+    }
+  }
+
+  partition_t parts_clipped;
+
+  auto range = ranges_merged.begin();
+  for (auto const &part : parts) {
+    // skip ranges that end before the part
+    while (range != ranges_merged.end() && range->second <= part.first)
+      ++range;
+    // overlap of the part with each range that begins before its end
+    for (auto rng = range;
+         rng != ranges_merged.end() && rng->first < part.second; ++rng) {
+      parts_clipped.emplace_back(std::max(part.first, rng->first),
+                                 std::min(part.second, rng->second));
+    }
+  }
+
+  return parts_clipped;
+}
+
+inline queryosity::dataset::partition_t
+queryosity::dataset::partition::sample(
+    queryosity::dataset::partition_t const &parts, double fraction,
+    unsigned long long seed, bool splittable) {
+  if (fraction >= 1.0 || !parts.size())
+    return parts;
+
+  // sample in (at least) a hundred blocks, so that even a dataset of a
+  // few parts can be sampled (unless its parts cannot be split)
+  const unsigned long long nblocks_min = 100;
+  partition_t blocks;
+  const auto nblocks_per_part =
+      splittable ? (nblocks_min + parts.size() - 1) / parts.size() : 1;
+  for (auto const &part : parts) {
+    const auto nentries = part.second - part.first;
+    const auto nblocks = std::max(1ULL, std::min(nblocks_per_part, nentries));
+    for (unsigned long long i = 0; i < nblocks; ++i) {
+      blocks.emplace_back(part.first + nentries * i / nblocks,
+                          part.first + nentries * (i + 1) / nblocks);
+    }
+  }
+
+  // shuffle the part indices (by hand, as the standard distributions are
+  // implementation-defined and would not be reproducible across platforms)
+  std::vector<std::size_t> indices(blocks.size());
+  std::iota(indices.begin(), indices.end(), 0);
+  std::mt19937_64 rng(seed);
+  for (auto i = indices.size() - 1; i > 0; --i) {
+    std::swap(indices[i], indices[rng() % (i + 1)]);
+  }
+
+  // keep (at least one of) the first blocks, in their original order
+  const auto nparts = std::max<std::size_t>(
+      1, std::llround(std::max(fraction, 0.0) * blocks.size()));
+  indices.resize(nparts);
+  std::sort(indices.begin(), indices.end());
+
+  partition_t parts_sampled;
+  for (auto i : indices) {
+    parts_sampled.push_back(blocks[i]);
+  }
+  return parts_sampled;
+}
+
+inline queryosity::dataset::partition_t
+queryosity::dataset::partition::regroup(
+    queryosity::dataset::partition_t const &parts, unsigned long long nentries,
+    bool splittable) {
+  if (!nentries)
+    return parts;
+
+  partition_t parts_regrouped;
+
+  for (auto const &part : parts) {
+    const auto nentries_part = part.second - part.first;
+    if (splittable && nentries_part > nentries) {
+      // split into even parts of (at most) the target size
+      const auto nsplits = (nentries_part + nentries - 1) / nentries;
+      for (unsigned long long i = 0; i < nsplits; ++i) {
+        parts_regrouped.emplace_back(
+            part.first + nentries_part * i / nsplits,
+            part.first + nentries_part * (i + 1) / nsplits);
+      }
+    } else if (parts_regrouped.size() &&
+               parts_regrouped.back().second == part.first &&
+               parts_regrouped.back().second - parts_regrouped.back().first +
+                       nentries_part <=
+                   nentries) {
+      // merge into the previous part while within the target size
+      parts_regrouped.back().second = part.second;
+    } else {
+      parts_regrouped.push_back(part);
+    }
+  }
+
+  return parts_regrouped;
+}
@@ -0,0 +1,518 @@
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "dataset.hpp"
+#include "dataset_reader.hpp"
+
+namespace queryosity {
+
+namespace dataset {
+
+/**
+ * @ingroup api
+ * @brief Dataset read out sequentially by a dedicated thread.
+ * @tparam DS Concrete implementation of `queryosity::dataset::reader`.
+ * @details The underlying dataset is processed by a single reader thread,
+ * which decodes the requested columns batch-by-batch into a bounded ring
+ * buffer. The batches are streamed to the thread slots as they are filled,
+ * such that the reading of the dataset runs concurrently with the processing
+ * of its entries. Once the ring buffer is full, the reader thread waits for a
+ * batch to be released by the slots before it moves on.
+ * @attention As with `queryosity::dataset::cached`, the columns are captured
+ * for every entry of a batch, whether or not they are actually used in the
+ * entry.
+ */
+template <typename DS> class pipelined : public reader<pipelined<DS>> {
+
+public:
+  class capture;
+
+  template <typename Val> class batches;
+
+  template <typename Val> class array;
+
+public:
+  /**
+   * @brief Constructor.
+   * @param[in] args Constructor arguments of the underlying dataset.
+   */
+  template <typename... Args> pipelined(Args &&...args);
+  virtual ~pipelined();
+
+  /**
+   * @brief Configure the ring buffer.
+   * @param[in] nentries Number of entries per batch.
+   * @param[in] nbatches Number of batches held at once (default: twice the
+   * number of thread slots).
+   */
+  void buffer(unsigned long long nentries, unsigned int nbatches = 0);
+
+  virtual void parallelize(unsigned int concurrency) final override;
+
+  virtual void initialize() final override;
+
+  virtual std::vector<std::pair<unsigned long long, unsigned long long>>
+  partition() final override;
+
+  virtual bool is_streaming() const final override;
+
+  virtual bool
+  fetch(std::pair<unsigned long long, unsigned long long> &part) final override;
+
+  virtual void initialize(unsigned int slot, unsigned long long begin,
+                          unsigned long long end) final override;
+
+  virtual void finalize(unsigned int slot) final override;
+
+  virtual void finalize() final override;
+
+  /**
+   * @brief Read a pipelined column.
+   * @tparam Val Column value type.
+   * @param[in] slot Thread slot number.
+   * @param[in] name Column name.
+   * @return Pipelined column.
+   */
+  template <typename Val>
+  std::unique_ptr<array<Val>> read(unsigned int slot, const std::string &name);
+
+  /**
+   * @brief Index of the batch currently held by a slot.
+   */
+  unsigned int get_batch(unsigned int slot) const { return m_held[slot]; }
+
+protected:
+  void run();
+  void stop();
+
+  /**
+   * @brief Get the values captured by a column under a variation.
+   * @param[in] name Column name.
+   * @param[in] variation_name Variation name (empty for the nominal).
+   * @details Each column is captured once per variation, and the captures
+   * that are no longer read are dropped.
+   */
+  template <typename Val>
+  std::shared_ptr<batches<Val>> capture_column(const std::string &name,
+                                               const std::string &variation_name);
+
+protected:
+  std::unique_ptr<DS> m_ds;
+  unsigned int m_nslots;
+  unsigned long long m_batch_size;
+  unsigned int m_nbatches;
+  // keyed by column & variation names
+  std::map<std::pair<std::string, std::string>, std::shared_ptr<capture>>
+      m_columns;
+  std::vector<std::pair<unsigned long long, unsigned long long>> m_partition;
+
+  // ring buffer, guarded by the mutex
+  std::thread m_reader;
+  std::mutex m_mutex;
+  std::condition_variable m_filled_cv;
+  std::condition_variable m_freed_cv;
+  std::vector<std::pair<unsigned long long, unsigned long long>> m_parts;
+  std::deque<unsigned int> m_free;
+  std::deque<unsigned int> m_filled;
+  std::map<unsigned long long, unsigned int> m_fetched;
+  std::vector<unsigned int> m_held;
+  bool m_ended;
+  bool m_stopped;
+  std::exception_ptr m_error;
+};
+
+/**
+ * @brief Pipelined column interface towards its dataset.
+ */
+template <typename DS> class pipelined<DS>::capture {
+
+public:
+  capture() = default;
+  virtual ~capture() = default;
+
+  /**
+   * @brief Allocate the values of each batch.
+   * @param[in] nbatches Number of batches.
+   */
+  virtual void allocate(unsigned int nbatches) = 0;
+
+  virtual void initialize(unsigned long long begin, unsigned long long end) = 0;
+
+  /**
+   * @brief Start capturing the values of a batch.
+   * @param[in] batch Batch index.
+   */
+  virtual void prepare(unsigned int batch) = 0;
+
+  /**
+   * @brief Capture the value of the column at an entry.
+   * @param[in] entry Entry being read.
+   */
+  virtual void record(unsigned long long entry) = 0;
+
+  virtual void finalize() = 0;
+};
+
+/**
+ * @brief Values of a column in each batch of the ring buffer.
+ * @tparam Val Column value type.
+ */
+template <typename DS>
+template <typename Val>
+class pipelined<DS>::batches : public pipelined<DS>::capture {
+
+public:
+  // std::vector<bool> cannot return references to its elements
+  using store_type = std::conditional_t<std::is_same_v<Val, bool>,
+                                        std::deque<Val>, std::vector<Val>>;
+
+public:
+  batches(std::unique_ptr<queryosity::column::reader<Val>> column);
+  virtual ~batches() = default;
+
+  virtual void allocate(unsigned int nbatches) final override;
+  virtual void initialize(unsigned long long begin,
+                          unsigned long long end) final override;
+  virtual void prepare(unsigned int batch) final override;
+  virtual void record(unsigned long long entry) final override;
+  virtual void finalize() final override;
+
+  store_type const &values(unsigned int batch) const {
+    return m_values[batch];
+  }
+
+protected:
+  std::unique_ptr<queryosity::column::reader<Val>> m_column;
+  std::vector<store_type> m_values;
+  store_type *m_batch;
+};
+
+/**
+ * @brief Pipelined column values served to a slot.
+ * @tparam Val Column value type.
+ */
+template <typename DS>
+template <typename Val>
+class pipelined<DS>::array : public queryosity::column::reader<Val> {
+
+public:
+  array(pipelined<DS> &ds, const std::string &name,
+        std::shared_ptr<batches<Val>> values);
+  virtual ~array() = default;
+
+  virtual Val const &read(unsigned int slot,
+                          unsigned long long entry) const final override;
+
+  virtual void initialize(unsigned int slot, unsigned long long begin,
+                          unsigned long long end) final override;
+
+  /**
+   * @brief Serve the values of the column under a variation instead.
+   * @details The varied column is captured separately, such that the
+   * nominal column (and other variations) read by others are left as-is.
+   */
+  virtual void vary(const std::string &variation_name) final override;
+
+protected:
+  pipelined<DS> *m_ds;
+  std::string m_name;
+  std::shared_ptr<batches<Val>> m_batches;
+  typename batches<Val>::store_type const *m_values;
+  unsigned long long m_begin;
+};
+
+} // namespace dataset
+
+} // namespace queryosity
+
+template <typename DS>
+template <typename... Args>
+queryosity::dataset::pipelined<DS>::pipelined(Args &&...args)
+    : m_ds(std::make_unique<DS>(std::forward<Args>(args)...)), m_nslots(1),
+      m_batch_size(1024), m_nbatches(0), m_ended(false), m_stopped(false) {}
+
+template <typename DS> queryosity::dataset::pipelined<DS>::~pipelined() {
+  this->stop();
+}
+
+template <typename DS>
+void queryosity::dataset::pipelined<DS>::buffer(unsigned long long nentries,
+                                                unsigned int nbatches) {
+  if (!nentries)
+    throw std::invalid_argument("batches must have at least one entry");
+  m_batch_size = nentries;
+  m_nbatches = nbatches;
+}
+
+template <typename DS>
+void queryosity::dataset::pipelined<DS>::parallelize(unsigned int concurrency) {
+  // the underlying dataset is only ever read from one thread
+  static_cast<source &>(*m_ds).parallelize(1);
+  m_nslots = concurrency;
+  m_held.assign(concurrency, 0);
+}
+
+template <typename DS> void queryosity::dataset::pipelined<DS>::initialize() {
+  static_cast<source &>(*m_ds).initialize();
+  m_partition = static_cast<source &>(*m_ds).partition();
+  if (!m_partition.size())
+    throw std::logic_error("pipelined dataset must have a partition");
+
+  const auto nbatches = m_nbatches ? m_nbatches : 2 * m_nslots;
+  for (auto const &col : m_columns) {
+    col.second->allocate(nbatches);
+  }
+  m_parts.assign(nbatches, {0, 0});
+  m_free.clear();
+  for (unsigned int i = 0; i < nbatches; ++i) {
+    m_free.push_back(i);
+  }
+  m_filled.clear();
+  m_fetched.clear();
+  m_ended = false;
+  m_stopped = false;
+  m_error = nullptr;
+  m_reader = std::thread(&pipelined<DS>::run, this);
+}
+
+template <typename DS>
+std::vector<std::pair<unsigned long long, unsigned long long>>
+queryosity::dataset::pipelined<DS>::partition() {
+  return {};
+}
+
+template <typename DS>
+bool queryosity::dataset::pipelined<DS>::is_streaming() const {
+  return true;
+}
+
+template <typename DS>
+bool queryosity::dataset::pipelined<DS>::fetch(
+    std::pair<unsigned long long, unsigned long long> &part) {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_filled_cv.wait(lock,
+                   [this]() { return m_filled.size() || m_ended || m_error; });
+  if (m_error)
+    std::rethrow_exception(m_error);
+  if (!m_filled.size())
+    return false;
+  const auto batch = m_filled.front();
+  m_filled.pop_front();
+  part = m_parts[batch];
+  m_fetched[part.first] = batch;
+  return true;
+}
+
+template <typename DS>
+void queryosity::dataset::pipelined<DS>::initialize(unsigned int slot,
+                                                    unsigned long long begin,
+                                                    unsigned long long) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto fetched = m_fetched.find(begin);
+  if (fetched == m_fetched.end())
+    throw std::logic_error(
+        "pipelined dataset can only be processed over its own batches");
+  m_held[slot] = fetched->second;
+  m_fetched.erase(fetched);
+}
+
+template <typename DS>
+void queryosity::dataset::pipelined<DS>::finalize(unsigned int slot) {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_free.push_back(m_held[slot]);
+  }
+  m_freed_cv.notify_one();
+}
+
+template <typename DS> void queryosity::dataset::pipelined<DS>::finalize() {
+  this->stop();
+  static_cast<source &>(*m_ds).finalize();
+}
+
+template <typename DS> void queryosity::dataset::pipelined<DS>::stop() {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stopped = true;
+  }
+  m_freed_cv.notify_all();
+  if (m_reader.joinable())
+    m_reader.join();
+}
+
+template <typename DS> void queryosity::dataset::pipelined<DS>::run() {
+  auto &ds = static_cast<source &>(*m_ds);
+  try {
+    for (auto const &part : m_partition) {
+      ds.initialize(0, part.first, part.second);
+      for (auto const &col : m_columns) {
+        col.second->initialize(part.first, part.second);
+      }
+      for (auto begin = part.first; begin < part.second;
+           begin += m_batch_size) {
+        // wait for a batch to be free
+        unsigned int batch;
+        {
+          std::unique_lock<std::mutex> lock(m_mutex);
+          m_freed_cv.wait(lock,
+                          [this]() { return m_free.size() || m_stopped; });
+          if (m_stopped)
+            break;
+          batch = m_free.front();
+          m_free.pop_front();
+        }
+        const auto end = std::min(begin + m_batch_size, part.second);
+        for (auto const &col : m_columns) {
+          col.second->prepare(batch);
+        }
+        for (auto entry = begin; entry < end; ++entry) {
+          ds.execute(0, entry);
+          for (auto const &col : m_columns) {
+            col.second->record(entry);
+          }
+        }
+        {
+          std::lock_guard<std::mutex> lock(m_mutex);
+          m_parts[batch] = {begin, end};
+          m_filled.push_back(batch);
+        }
+        m_filled_cv.notify_one();
+      }
+      for (auto const &col : m_columns) {
+        col.second->finalize();
+      }
+      ds.finalize(0);
+      std::lock_guard<std::mutex> lock(m_mutex);
+      if (m_stopped)
+        break;
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_ended = true;
+  } catch (...) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_error = std::current_exception();
+  }
+  m_filled_cv.notify_all();
+}
+
+template <typename DS>
+template <typename Val>
+std::unique_ptr<typename queryosity::dataset::pipelined<DS>::template array<Val>>
+queryosity::dataset::pipelined<DS>::read(unsigned int,
+                                         const std::string &name) {
+  // all slots are served the values captured by one column
+  return std::make_unique<array<Val>>(*this, name,
+                                      this->capture_column<Val>(name, ""));
+}
+
+template <typename DS>
+template <typename Val>
+std::shared_ptr<
+    typename queryosity::dataset::pipelined<DS>::template batches<Val>>
+queryosity::dataset::pipelined<DS>::capture_column(
+    const std::string &name, const std::string &variation_name) {
+  auto &col = m_columns[{name, variation_name}];
+  if (!col) {
+    auto column = m_ds->template read_column<Val>(0, name);
+    if (variation_name.size())
+      column->vary(variation_name);
+    col = std::make_shared<batches<Val>>(std::move(column));
+  }
+  auto values = std::dynamic_pointer_cast<batches<Val>>(col);
+  if (!values)
+    throw std::logic_error("pipelined column read as a different type");
+  // (columns that have since been varied by all of their readers)
+  for (auto it = m_columns.begin(); it != m_columns.end();) {
+    if (it->second.use_count() == 1)
+      it = m_columns.erase(it);
+    else
+      ++it;
+  }
+  return values;
+}
+
+template <typename DS>
+template <typename Val>
+queryosity::dataset::pipelined<DS>::batches<Val>::batches(
+    std::unique_ptr<queryosity::column::reader<Val>> column)
+    : m_column(std::move(column)), m_batch(nullptr) {}
+
+template <typename DS>
+template <typename Val>
+void queryosity::dataset::pipelined<DS>::batches<Val>::allocate(
+    unsigned int nbatches) {
+  m_values.resize(nbatches);
+}
+
+template <typename DS>
+template <typename Val>
+void queryosity::dataset::pipelined<DS>::batches<Val>::initialize(
+    unsigned long long begin, unsigned long long end) {
+  m_column->initialize(0, begin, end);
+}
+
+template <typename DS>
+template <typename Val>
+void queryosity::dataset::pipelined<DS>::batches<Val>::prepare(
+    unsigned int batch) {
+  m_batch = &m_values[batch];
+  m_batch->clear();
+}
+
+template <typename DS>
+template <typename Val>
+void queryosity::dataset::pipelined<DS>::batches<Val>::record(
+    unsigned long long entry) {
+  m_batch->push_back(m_column->read(0, entry));
+}
+
+template <typename DS>
+template <typename Val>
+void queryosity::dataset::pipelined<DS>::batches<Val>::finalize() {
+  m_column->finalize(0);
+}
+
+template <typename DS>
+template <typename Val>
+queryosity::dataset::pipelined<DS>::array<Val>::array(
+    pipelined<DS> &ds, const std::string &name,
+    std::shared_ptr<batches<Val>> values)
+    : m_ds(&ds), m_name(name), m_batches(std::move(values)), m_values(nullptr),
+      m_begin(0) {}
+
+template <typename DS>
+template <typename Val>
+Val const &queryosity::dataset::pipelined<DS>::array<Val>::read(
+    unsigned int, unsigned long long entry) const {
+  return (*m_values)[entry - m_begin];
+}
+
+template <typename DS>
+template <typename Val>
+void queryosity::dataset::pipelined<DS>::array<Val>::initialize(
+    unsigned int slot, unsigned long long begin, unsigned long long) {
+  // the dataset has already been handed the batch of the slot
+  m_values = &m_batches->values(m_ds->get_batch(slot));
+  m_begin = begin;
+}
+
+template <typename DS>
+template <typename Val>
+void queryosity::dataset::pipelined<DS>::array<Val>::vary(
+    const std::string &variation_name) {
+  m_batches.reset();
+  m_batches = m_ds->template capture_column<Val>(m_name, variation_name);
+}
@@ -1,5 +1,9 @@
 #pragma once
 
+#include <atomic>
+#include <chrono>
+#include <functional>
+
 #include "column_computation.hpp"
 #include "query_experiment.hpp"
 
@@ -9,13 +13,62 @@ namespace dataset {
 
 class player : public query::experiment {
 
+public:
+  /**
+   * @brief Number of entries processed in-between checks of the deadline.
+   */
+  static constexpr unsigned long long deadline_interval = 1024;
+
 public:
   player() = default;
   virtual ~player() = default;
 
 public:
+  /**
+   * @brief Play over parts of the dataset handed out one at a time.
+   * @param[in] next Function that assigns the next part, or returns `false`
+   * if there are none left.
+   */
   void play(std::vector<std::unique_ptr<source>> const &sources, double scale,
-            slot_t slot, std::vector<part_t> const &parts);
+            slot_t slot, std::function<bool(part_t &)> const &next,
+            std::chrono::steady_clock::time_point deadline,
+            std::atomic<bool> const &cancelled);
+
+  /**
+   * @brief Number of entries processed in the latest play.
+   */
+  unsigned long long get_processed() const;
+
+  /**
+   * @brief Queries to be played (in the order that they were booked).
+   */
+  std::vector<query::node *> const &get_queries() const;
+
+protected:
+  /**
+   * @brief Per-entry work of a single action.
+   */
+  struct step {
+    execute_t execute;
+    action *node;
+  };
+
+  /**
+   * @brief Compile the actions that need to be executed for each entry into a
+   * flat sequence of steps.
+   * @details Only the dataset sources, the columns that override `execute()`,
+   * and the queries that are counted on their own (in that order) are
+   * included: any other columns and selections are computed on-demand, and
+   * query variations are counted by their nominal.
+   * The queries that are yet to be done are also tallied up, such that the
+   * processing stops once none of them are left.
+   */
+  void compile(std::vector<std::unique_ptr<source>> const &sources);
+
+protected:
+  std::vector<step> m_plan;
+  unsigned int m_pending = 0;
+  unsigned long long m_processed = 0;
 };
 
 } // namespace dataset
@@ -26,15 +79,31 @@ public:
 
 inline void queryosity::dataset::player::play(
     std::vector<std::unique_ptr<source>> const &sources, double scale,
-    slot_t slot, std::vector<part_t> const &parts) {
+    slot_t slot, std::function<bool(part_t &)> const &next,
+    std::chrono::steady_clock::time_point deadline,
+    std::atomic<bool> const &cancelled) {
 
   // apply dataset scale in effect for all queries
   for (auto const &qry : m_queries) {
     qry->apply_scale(scale);
   }
 
+  this->compile(sources);
+  // stop early only if there are queries to be done
+  const bool stoppable = m_pending;
+  const bool timed = deadline != std::chrono::steady_clock::time_point::max();
+  m_processed = 0;
+
   // traverse each part
-  for (auto const &part : parts) {
+  part_t part;
+  while (true) {
+    // stop cleanly in-between parts
+    if (cancelled.load(std::memory_order_relaxed) ||
+        (stoppable && !m_pending) ||
+        std::chrono::steady_clock::now() >= deadline)
+      break;
+    if (!next(part))
+      break;
     // initialize
     for (auto const &ds : sources) {
       ds->initialize(slot, part.first, part.second);
@@ -49,22 +118,29 @@ inline void queryosity::dataset::player::play(
       qry->initialize(slot, part.first, part.second);
     }
     // execute
-    for (auto entry = part.first; entry < part.second; ++entry) {
-      for (auto const &ds : sources) {
-        ds->execute(slot, entry);
+    m_cursor.slot = slot;
+    auto entry = part.first;
+    for (; entry < part.second; ++entry) {
+      // columns & selections are not executed (unless a column overrides it):
+      // advancing the epoch suffices to invalidate their values from the
+      // previous entry
+      m_cursor.entry = entry;
+      ++m_cursor.epoch;
+      for (auto const &stp : m_plan) {
+        stp.execute(stp.node, slot, entry);
       }
-      for (auto const &col : m_columns) {
-        col->execute(slot, entry);
-      }
-      for (auto const &sel : m_selections) {
-        sel->execute(slot, entry);
-      }
-      for (auto const &qry : m_queries) {
-        qry->execute(slot, entry);
+      // all queries are done (or out of time): the part is finalized as-is
+      if ((stoppable && !m_pending) ||
+          (timed && !((entry - part.first + 1) % deadline_interval) &&
+           std::chrono::steady_clock::now() >= deadline)) {
+        ++entry;
+        break;
       }
     }
+    m_processed += entry - part.first;
     // finalize (in reverse order)
     for (auto const &qry : m_queries) {
+      qry->flush();
       qry->finalize(slot);
     }
     for (auto const &sel : m_selections) {
@@ -80,4 +156,43 @@ inline void queryosity::dataset::player::play(
 
   // clear out queries (should not be re-played)
   m_queries.clear();
+  m_executes.clear();
+  m_plan.clear();
+  m_pending = 0;
+}
+
+inline unsigned long long queryosity::dataset::player::get_processed() const {
+  return m_processed;
+}
+
+inline std::vector<queryosity::query::node *> const &
+queryosity::dataset::player::get_queries() const {
+  return m_queries;
+}
+
+inline void queryosity::dataset::player::compile(
+    std::vector<std::unique_ptr<source>> const &sources) {
+  m_plan.clear();
+  m_plan.reserve(sources.size() + m_executed_columns.size() +
+                 m_queries.size());
+  auto execute = [](action *act, unsigned int slot, unsigned long long entry) {
+    act->execute(slot, entry);
+  };
+  for (auto const &ds : sources) {
+    m_plan.push_back({execute, ds.get()});
+  }
+  for (auto const &col : m_executed_columns) {
+    m_plan.push_back({execute, col});
+  }
+  m_pending = 0;
+  for (unsigned int i = 0; i < m_queries.size(); ++i) {
+    if (!m_queries[i]->is_done()) {
+      m_queries[i]->set_pending(&m_pending);
+      ++m_pending;
+    }
+    // counted alongside its nominal
+    if (m_queries[i]->get_nominal())
+      continue;
+    m_plan.push_back({m_executes[i], m_queries[i]});
+  }
 }
\ No newline at end of file
@@ -1,6 +1,23 @@
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <csignal>
+#include <functional>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <system_error>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <poll.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
 #include "dataset.hpp"
+#include "dataset_monitor.hpp"
 #include "dataset_player.hpp"
 #include "multithread.hpp"
 
@@ -10,7 +27,7 @@ namespace dataset {
 
 class processor : public multithread::core, public ensemble::slotted<player> {
 public:
-  processor(int suggestion);
+  processor(int suggestion, unsigned int nprocesses = 1);
   virtual ~processor() = default;
 
   processor(const processor &) = delete;
@@ -25,14 +42,48 @@ public:
 
   void downsize(unsigned int nslots);
   void process(std::vector<std::unique_ptr<source>> const &sources,
-               double scale, unsigned long long nrows);
+               double scale, partition_t const &ranges,
+               unsigned long long offset, unsigned long long nrows,
+               unsigned long long granularity, dataset::sample const &sample,
+               dataset::budget const &budget, dataset::window const &window,
+               std::function<void()> const &on_window,
+               std::atomic<bool> const &cancelled);
+
+  /**
+   * @brief Fraction of the dataset entries processed in the latest run.
+   */
+  double get_fraction() const;
+
+  /**
+   * @brief Number of worker processes that the dataset is processed in.
+   */
+  unsigned int processes() const { return m_nprocesses; }
 
   virtual std::vector<player *> const &get_slots() const override;
 
+protected:
+  unsigned long long
+  dispatch(std::vector<std::unique_ptr<source>> const &sources, double scale,
+           partition_t const &parts,
+           std::chrono::steady_clock::time_point deadline,
+           dataset::monitor &monitor, std::atomic<bool> const &cancelled);
+
+  unsigned long long
+  fork(std::vector<std::unique_ptr<source>> const &sources, double scale,
+       partition_t const &parts, std::chrono::steady_clock::time_point deadline,
+       dataset::monitor &monitor, std::atomic<bool> const &cancelled);
+
+  void stream(std::vector<std::unique_ptr<source>> const &sources,
+              source &stream, double scale, unsigned long long nrows,
+              std::chrono::steady_clock::time_point deadline,
+              dataset::monitor &monitor, std::atomic<bool> const &cancelled);
+
 protected:
   std::vector<unsigned int> m_range_slots;
   std::vector<dataset::player> m_players;
   std::vector<dataset::player *> m_player_ptrs;
+  unsigned int m_nprocesses;
+  double m_fraction;
 };
 
 } // namespace dataset
@@ -44,6 +95,21 @@ dataset::processor disable();
 
 } // namespace multithread
 
+namespace multiprocess {
+
+/**
+ * @ingroup api
+ * @brief Process the dataset with multiple (single-threaded) processes.
+ * @param[in] suggestion Number of worker processes (default: as many as there
+ * are hardware threads).
+ * @details Each worker process is forked off to process its own share of the
+ * dataset partition, and sends back the results of its queries to be merged
+ * (see `query::node::serialize()`).
+ */
+dataset::processor enable(int suggestion = -1);
+
+} // namespace multiprocess
+
 } // namespace queryosity
 
 inline queryosity::dataset::processor
@@ -55,8 +121,16 @@ inline queryosity::dataset::processor queryosity::multithread::disable() {
   return dataset::processor(false);
 }
 
-inline queryosity::dataset::processor::processor(int suggestion)
-    : multithread::core::core(suggestion), m_range_slots(), m_players(), m_player_ptrs() {
+inline queryosity::dataset::processor
+queryosity::multiprocess::enable(int suggestion) {
+  if (suggestion < 0)
+    suggestion = std::thread::hardware_concurrency();
+  return dataset::processor(false, std::max(suggestion, 1));
+}
+
+inline queryosity::dataset::processor::processor(int suggestion,
+                                                 unsigned int nprocesses)
+    : multithread::core::core(suggestion), m_range_slots(), m_players(), m_player_ptrs(), m_nprocesses(nprocesses), m_fraction(1.0) {
   const auto nslots = this->concurrency();
   m_players = std::vector<player>(nslots);
   m_player_ptrs = std::vector<player *>(nslots, nullptr);
@@ -94,61 +168,415 @@ inline void queryosity::dataset::processor::downsize(unsigned int nslots) {
 
 inline void queryosity::dataset::processor::process(
     std::vector<std::unique_ptr<source>> const &sources, double scale,
-    unsigned long long nrows) {
+    partition_t const &ranges, unsigned long long offset,
+    unsigned long long nrows, unsigned long long granularity,
+    dataset::sample const &sample, dataset::budget const &budget,
+    dataset::window const &window, std::function<void()> const &on_window,
+    std::atomic<bool> const &cancelled) {
 
-  const auto nslots = this->concurrency();
+  if (m_nprocesses > 1) {
+    if (window.is_enabled())
+      throw std::logic_error(
+          "windowed processing is not supported with multiple processes");
+    if (std::any_of(
+            sources.begin(), sources.end(),
+            [](std::unique_ptr<source> const &ds) { return ds->is_streaming(); }))
+      throw std::logic_error(
+          "streaming dataset cannot be processed with multiple processes");
+  }
+
+  // queries performed in this run, per slot (the players let go of them once
+  // played)
+  std::vector<std::vector<query::node *>> queries;
+  for (auto const &plyr : m_player_ptrs) {
+    queries.push_back(plyr->get_queries());
+  }
 
   // 1. enter event loop
   for (auto const &ds : sources) {
     ds->initialize();
   }
+  const auto deadline =
+      budget.duration == std::chrono::steady_clock::duration::max()
+          ? std::chrono::steady_clock::time_point::max()
+          : std::chrono::steady_clock::now() + budget.duration;
+  // copy the results in-between windows (with all slots on hold), which
+  // are published once the slots have resumed
+  auto snapshot = [&queries, &window]() {
+    std::vector<query::node *> slots(queries.size());
+    for (size_t iqry = 0; iqry < queries.front().size(); ++iqry) {
+      for (size_t islot = 0; islot < queries.size(); ++islot) {
+        slots[islot] = queries[islot][iqry];
+      }
+      queries.front()[iqry]->snapshot(slots, window.nsteps);
+    }
+    if (window.tumbling) {
+      for (auto const &slot : queries) {
+        for (auto const &qry : slot) {
+          qry->reset();
+        }
+      }
+    }
+  };
+  dataset::monitor monitor(window, m_player_ptrs.size(), snapshot, on_window);
+
+  // (streaming dataset: there is no partition to speak of)
+  auto streaming = std::find_if(
+      sources.begin(), sources.end(),
+      [](std::unique_ptr<source> const &ds) { return ds->is_streaming(); });
+  if (streaming != sources.end()) {
+    if (ranges.size() || offset || granularity || sample.fraction < 1.0)
+      throw std::logic_error("streaming dataset cannot be processed with "
+                             "entry ranges, offset, granularity or sampling");
+    this->stream(sources, **streaming, scale, nrows, deadline, monitor,
+                 cancelled);
+    for (auto const &slot : queries) {
+      for (auto const &qry : slot) {
+        qry->set_fraction(m_fraction);
+      }
+    }
+    for (auto const &ds : sources) {
+      ds->finalize();
+    }
+    return;
+  }
 
   // 2. partition dataset(s)
   // 2.1 get partition from each dataset source
   std::vector<partition_t> partitions_from_sources;
+  std::vector<bool> splittable_sources;
   for (auto const &ds : sources) {
     auto partition_from_source = ds->partition();
-    if (partition_from_source.size())
+    if (partition_from_source.size()) {
       partitions_from_sources.push_back(std::move(partition_from_source));
+      splittable_sources.push_back(ds->is_splittable());
+    }
   }
+  const bool splittable = std::all_of(splittable_sources.begin(),
+                                      splittable_sources.end(),
+                                      [](bool splittable) { return splittable; });
   if (!partitions_from_sources.size()) {
     throw std::runtime_error("no valid dataset partition found");
   }
-  // 2.2 find common denominator partition
-  const auto partition_aligned =
-      dataset::partition::align(partitions_from_sources);
-  // 2.3 truncate entries to row limit
+  // 2.2 find common denominator partition (of the sources with fixed
+  // boundaries)
+  const auto partition_aligned = dataset::partition::align(
+      partitions_from_sources, splittable_sources);
+  // 2.3 clip entries to requested ranges, offset & row limit
+  const auto partition_clipped =
+      dataset::partition::clip(partition_aligned, ranges);
+  const auto partition_skipped =
+      dataset::partition::skip(partition_clipped, offset);
   const auto partition_truncated =
-      dataset::partition::truncate(partition_aligned, nrows);
-  // 2.3 distribute partition amongst threads
-  std::vector<partition_t> partitions_for_slots(nslots);
-  auto nparts_remaining = partition_truncated.size();
-  const auto nparts = nparts_remaining;
-  while (nparts_remaining) {
-    for (unsigned int islot = 0; islot < nslots; ++islot) {
-      partitions_for_slots[islot].push_back(
-          std::move(partition_truncated[nparts - (nparts_remaining--)]));
-      if (!nparts_remaining)
-        break;
+      dataset::partition::truncate(partition_skipped, nrows);
+  // 2.4 sample parts, extrapolating to the entries left out
+  const auto partition_sampled = dataset::partition::sample(
+      partition_truncated, sample.fraction, sample.seed, splittable);
+  auto count_entries = [](partition_t const &parts) {
+    unsigned long long nentries = 0;
+    for (auto const &part : parts) {
+      nentries += part.second - part.first;
     }
+    return nentries;
+  };
+  const auto nentries_total = count_entries(partition_truncated);
+  const auto nentries_sampled = count_entries(partition_sampled);
+  if (nentries_sampled && nentries_sampled < nentries_total)
+    scale *= double(nentries_total) / double(nentries_sampled);
+  // 2.5 regroup parts to the requested granularity
+  const auto partition_regrouped = dataset::partition::regroup(
+      partition_sampled, granularity, splittable);
+  // 3. run event loop (in worker processes, if enabled)
+  const auto nentries_processed =
+      m_nprocesses > 1 ? this->fork(sources, scale, partition_regrouped,
+                                    deadline, monitor, cancelled)
+                       : this->dispatch(sources, scale, partition_regrouped,
+                                        deadline, monitor, cancelled);
+  m_fraction = nentries_total ? double(nentries_processed) / nentries_total
+                              : 1.0;
+  for (auto const &slot : queries) {
+    for (auto const &qry : slot) {
+      qry->set_fraction(m_fraction);
+    }
+  }
+
+  // 4. exit event loop
+  for (auto const &ds : sources) {
+    ds->finalize();
+  }
+}
+
+inline unsigned long long queryosity::dataset::processor::dispatch(
+    std::vector<std::unique_ptr<source>> const &sources, double scale,
+    partition_t const &parts, std::chrono::steady_clock::time_point deadline,
+    dataset::monitor &monitor, std::atomic<bool> const &cancelled) {
+  // distribute partition amongst threads
+  // (each slot is handed a contiguous share of the parts, such that the
+  // results merged in the order of the slots are in the order of the entries)
+  const auto nslots = this->concurrency();
+  std::vector<partition_t> partitions_for_slots(nslots);
+  for (size_t islot = 0; islot < nslots; ++islot) {
+    partitions_for_slots[islot].assign(
+        parts.begin() + islot * parts.size() / nslots,
+        parts.begin() + (islot + 1) * parts.size() / nslots);
   }
   // todo: can intel tbb distribute slots during parallel processing?
 
-  // 3. run event loop
   this->run(
-      [&sources, scale](
+      [&sources, scale, deadline, &monitor, &cancelled](
           dataset::player *plyr, unsigned int slot,
           std::vector<std::pair<unsigned long long, unsigned long long>> const
-              &parts) { plyr->play(sources, scale, slot, parts); },
+              &parts) {
+        auto part = parts.begin();
+        plyr->play(sources, scale, slot,
+                   monitor.watch([&parts, &part](part_t &next) {
+                     if (part == parts.end())
+                       return false;
+                     next = *(part++);
+                     return true;
+                   }),
+                   deadline, cancelled);
+        monitor.leave();
+      },
       m_player_ptrs, m_range_slots, partitions_for_slots);
+  unsigned long long nentries_processed = 0;
+  for (auto const &plyr : m_player_ptrs) {
+    nentries_processed += plyr->get_processed();
+  }
+  return nentries_processed;
+}
 
-  // 4. exit event loop
+inline unsigned long long queryosity::dataset::processor::fork(
+    std::vector<std::unique_ptr<source>> const &sources, double scale,
+    partition_t const &parts, std::chrono::steady_clock::time_point deadline,
+    dataset::monitor &monitor, std::atomic<bool> const &cancelled) {
+#if defined(__unix__) || defined(__APPLE__)
+  // queries to be sent back from the workers (they are cleared once played)
+  std::vector<std::vector<query::node *>> queries;
+  for (auto const &plyr : m_player_ptrs) {
+    queries.push_back(plyr->get_queries());
+  }
+
+  // each worker is handed a contiguous share of the parts
+  const auto nworkers = std::max<size_t>(
+      std::min<size_t>(m_nprocesses, parts.size()), 1);
+  std::vector<pid_t> pids;
+  std::vector<int> fds;
+  auto reap = [&pids, &fds](bool kill) {
+    for (size_t iworker = 0; iworker < pids.size(); ++iworker) {
+      if (fds[iworker] >= 0)
+        ::close(fds[iworker]);
+      if (kill)
+        ::kill(pids[iworker], SIGKILL);
+    }
+    std::vector<int> statuses;
+    for (auto const &pid : pids) {
+      int status = 0;
+      while (::waitpid(pid, &status, 0) < 0 && errno == EINTR)
+        ;
+      statuses.push_back(status);
+    }
+    pids.clear();
+    fds.clear();
+    return statuses;
+  };
+  for (size_t iworker = 0; iworker < nworkers; ++iworker) {
+    int fd[2];
+    if (::pipe(fd) < 0) {
+      reap(true);
+      throw std::system_error(errno, std::generic_category(),
+                              "failed to open pipe to worker process");
+    }
+    const auto pid = ::fork();
+    if (pid < 0) {
+      ::close(fd[0]);
+      ::close(fd[1]);
+      reap(true);
+      throw std::system_error(errno, std::generic_category(),
+                              "failed to fork worker process");
+    }
+    if (pid == 0) {
+      // worker: process its share, then write out the results
+      ::close(fd[0]);
+      for (auto const &other : fds) {
+        ::close(other);
+      }
+      // (or the error that it ran into)
+      int status = 0;
+      std::string buffer;
+      try {
+        partition_t share(parts.begin() + iworker * parts.size() / nworkers,
+                          parts.begin() +
+                              (iworker + 1) * parts.size() / nworkers);
+        const auto nentries = this->dispatch(sources, scale, share, deadline,
+                                             monitor, cancelled);
+        for (auto const &ds : sources) {
+          ds->finalize();
+        }
+        std::ostringstream out(std::ios::binary);
+        out.write(reinterpret_cast<char const *>(&nentries), sizeof(nentries));
+        for (auto const &slot : queries) {
+          for (auto const &qry : slot) {
+            qry->serialize(out);
+          }
+        }
+        buffer = out.str();
+      } catch (std::exception const &e) {
+        buffer = e.what();
+        status = 1;
+      } catch (...) {
+        buffer = "unknown error";
+        status = 1;
+      }
+      for (size_t written = 0; written < buffer.size();) {
+        const auto n =
+            ::write(fd[1], buffer.data() + written, buffer.size() - written);
+        if (n < 0 && errno == EINTR)
+          continue;
+        if (n <= 0) {
+          status = 1;
+          break;
+        }
+        written += n;
+      }
+      ::close(fd[1]);
+      // skip the clean-up of the parent process state
+      ::_exit(status);
+    }
+    ::close(fd[1]);
+    pids.push_back(pid);
+    fds.push_back(fd[0]);
+  }
+
+  // collect the results from all workers as they come
+  std::vector<std::string> buffers(nworkers);
+  size_t nopen = nworkers;
+  while (nopen) {
+    if (cancelled.load(std::memory_order_relaxed)) {
+      reap(true);
+      this->dispatch(sources, scale, {}, deadline, monitor, cancelled);
+      return 0;
+    }
+    std::vector<pollfd> polled;
+    std::vector<size_t> polled_workers;
+    for (size_t iworker = 0; iworker < nworkers; ++iworker) {
+      if (fds[iworker] < 0)
+        continue;
+      polled.push_back({fds[iworker], POLLIN, 0});
+      polled_workers.push_back(iworker);
+    }
+    if (::poll(polled.data(), polled.size(), 100) < 0) {
+      if (errno == EINTR)
+        continue;
+      reap(true);
+      throw std::system_error(errno, std::generic_category(),
+                              "failed to poll worker processes");
+    }
+    for (size_t ipolled = 0; ipolled < polled.size(); ++ipolled) {
+      if (!polled[ipolled].revents)
+        continue;
+      const auto iworker = polled_workers[ipolled];
+      char chunk[65536];
+      const auto n = ::read(fds[iworker], chunk, sizeof(chunk));
+      if (n < 0 && errno == EINTR)
+        continue;
+      if (n > 0) {
+        buffers[iworker].append(chunk, n);
+        continue;
+      }
+      // end of results (or broken pipe)
+      ::close(fds[iworker]);
+      fds[iworker] = -1;
+      --nopen;
+    }
+  }
+  const auto statuses = reap(false);
+  for (size_t iworker = 0; iworker < nworkers; ++iworker) {
+    if (!WIFEXITED(statuses[iworker]) || WEXITSTATUS(statuses[iworker]))
+      throw std::runtime_error("worker process failed: " + buffers[iworker]);
+  }
+
+  unsigned long long nentries_processed = 0;
+  for (auto const &buffer : buffers) {
+    std::istringstream in(buffer, std::ios::binary);
+    unsigned long long nentries = 0;
+    in.read(reinterpret_cast<char *>(&nentries), sizeof(nentries));
+    nentries_processed += nentries;
+    for (auto const &slot : queries) {
+      for (auto const &qry : slot) {
+        qry->deserialize(in);
+      }
+    }
+  }
+
+  // the queries have been played by the workers
+  this->dispatch(sources, scale, {}, deadline, monitor, cancelled);
+  return nentries_processed;
+#else
+  (void)sources;
+  (void)scale;
+  (void)parts;
+  (void)deadline;
+  (void)monitor;
+  (void)cancelled;
+  throw std::runtime_error(
+      "multi-process processing is not supported on this platform");
+#endif
+}
+
+inline void queryosity::dataset::processor::stream(
+    std::vector<std::unique_ptr<source>> const &sources, source &stream,
+    double scale, unsigned long long nrows,
+    std::chrono::steady_clock::time_point deadline, dataset::monitor &monitor,
+    std::atomic<bool> const &cancelled) {
+  // all other datasets must follow along the stream
   for (auto const &ds : sources) {
-    ds->finalize();
+    if (ds.get() != &stream && ds->partition().size())
+      throw std::logic_error(
+          "streaming dataset cannot be combined with a partitioned one");
+  }
+
+  // hand out chunks to whichever slot asks first
+  std::mutex mutex;
+  bool ended = false;
+  unsigned long long nentries_fetched = 0;
+  std::function<bool(part_t &)> fetch = [&](part_t &part) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (ended || !stream.fetch(part)) {
+      ended = true;
+      return false;
+    }
+    // truncate entries to row limit
+    if (part.second - part.first > nrows - nentries_fetched) {
+      part.second = part.first + (nrows - nentries_fetched);
+      ended = true;
+    }
+    nentries_fetched += part.second - part.first;
+    return true;
+  };
+
+  this->run(
+      [&sources, scale, &fetch, deadline, &monitor,
+       &cancelled](dataset::player *plyr, unsigned int slot) {
+        plyr->play(sources, scale, slot, monitor.watch(fetch), deadline,
+                   cancelled);
+        monitor.leave();
+      },
+      m_player_ptrs, m_range_slots);
+  unsigned long long nentries_processed = 0;
+  for (auto const &plyr : m_player_ptrs) {
+    nentries_processed += plyr->get_processed();
   }
+  m_fraction = nentries_fetched
+                   ? double(nentries_processed) / nentries_fetched
+                   : 1.0;
 }
 
 inline std::vector<queryosity::dataset::player *> const &
 queryosity::dataset::processor::get_slots() const {
   return m_player_ptrs;
-}
\ No newline at end of file
+}
+
+inline double queryosity::dataset::processor::get_fraction() const {
+  return m_fraction;
+}
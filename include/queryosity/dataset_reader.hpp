@@ -49,6 +49,35 @@ public:
   virtual std::vector<std::pair<unsigned long long, unsigned long long>>
   partition() = 0;
 
+  /**
+   * @brief Whether the dataset can be processed over parts of any boundaries.
+   * @return `true` if the entry loop can begin and end at any entry.
+   * @details If so, the parts of its partition may be split up further for
+   * load-balancing. Adjacent parts are merged regardless.
+   */
+  virtual bool is_splittable() const;
+
+  /**
+   * @brief Whether the dataset is a stream of unknown length.
+   * @return `true` if the entries are to be fetched chunk-by-chunk.
+   * @details A streaming dataset reports an empty partition: instead, its
+   * chunks are dispatched to the thread slots as they become available, until
+   * the end of the stream.
+   */
+  virtual bool is_streaming() const;
+
+  /**
+   * @brief Fetch the next chunk of a streaming dataset.
+   * @param[out] part Entry range of the chunk.
+   * @return `false` if the stream has ended (`part` is then ignored).
+   * @details Chunks **MUST** be contiguous, i.e. each one begins where the
+   * previous one ended (starting from `0`). This method is only called from
+   * one thread at a time, and can block until the next chunk is available;
+   * its entries should remain readable by any slot until the chunk has been
+   * finalized.
+   */
+  virtual bool fetch(std::pair<unsigned long long, unsigned long long> &part);
+
   /**
    * @brief Enter an entry loop.
    * @param[in] slot Thread slot number.
@@ -117,6 +146,17 @@ using read_column_t =
 
 inline void queryosity::dataset::source::initialize() {}
 
+inline bool queryosity::dataset::source::is_splittable() const {
+  return false;
+}
+
+inline bool queryosity::dataset::source::is_streaming() const { return false; }
+
+inline bool queryosity::dataset::source::fetch(
+    std::pair<unsigned long long, unsigned long long> &) {
+  return false;
+}
+
 inline void queryosity::dataset::source::initialize(unsigned int,
                                                     unsigned long long,
                                                     unsigned long long) {}
@@ -45,13 +45,16 @@
                          column::value_t<typename Arg::action_type>>::value),  \
                 bool>::type = true>                                            \
   auto operator op_symbol(Arg const &arg) const {                              \
-    return this->m_df                                                          \
-        ->define(queryosity::column::expression(                               \
-            [](column::value_t<V> const &me,                                   \
-               column::value_t<typename Arg::action_type> const &you) {        \
-              return me op_symbol you;                                         \
-            }))                                                                \
-        .template evaluate(*this, arg);                                        \
+    auto fn = [](column::value_t<V> const &me,                                 \
+                 column::value_t<typename Arg::action_type> const &you) {      \
+      return me op_symbol you;                                                 \
+    };                                                                         \
+    if constexpr (queryosity::is_nominal_v<Arg>) {                             \
+      return this->m_df->_fuse(fn, *this, arg);                                \
+    } else {                                                                   \
+      return this->m_df->define(queryosity::column::expression(fn))            \
+          .template evaluate(*this, arg);                                      \
+    }                                                                          \
   }
 
 #define CHECK_FOR_UNARY_OP(op_name, op_symbol)                                 \
@@ -73,10 +76,8 @@
                            detail::has_##op_name##_v<column::value_t<V>>,      \
                        bool> = false>                                          \
   auto operator op_symbol() const {                                            \
-    return this->m_df                                                          \
-        ->define(queryosity::column::expression(                               \
-            [](column::value_t<V> const &me) { return (op_symbol me); }))      \
-        .template evaluate(*this);                                             \
+    return this->m_df->_fuse(                                                  \
+        [](column::value_t<V> const &me) { return (op_symbol me); }, *this);   \
   }
 
 #define CHECK_FOR_INDEX_OP()                                                   \
@@ -104,13 +105,16 @@
                                column::value_t<typename Arg::action_type>>,    \
                        bool> = false>                                          \
   auto operator[](Arg const &arg) const {                                      \
-    return this->m_df                                                          \
-        ->define(queryosity::column::expression(                               \
-            [](column::value_t<V> me,                                          \
-               column::value_t<typename Arg::action_type> index) {             \
-              return me[index];                                                \
-            }))                                                                \
-        .template evaluate(*this, arg);                                        \
+    auto fn = [](column::value_t<V> me,                                        \
+                 column::value_t<typename Arg::action_type> index) {           \
+      return me[index];                                                        \
+    };                                                                         \
+    if constexpr (queryosity::is_nominal_v<Arg>) {                             \
+      return this->m_df->_fuse(fn, *this, arg);                                \
+    } else {                                                                   \
+      return this->m_df->define(queryosity::column::expression(fn))            \
+          .template evaluate(*this, arg);                                      \
+    }                                                                          \
   }
 
 #define DECLARE_LAZY_VARIED_BINARY_OP(op_symbol)                               \
@@ -140,6 +144,10 @@
             b.nominal()))::action_type>>(                                      \
         this->nominal().operator op_symbol(b.nominal()));                      \
     for (auto const &var_name : systematic::get_variation_names(*this, b)) {   \
+      if (systematic::is_nominal(var_name, *this, b)) {                        \
+        syst.share_nominal(var_name);                                          \
+        continue;                                                              \
+      }                                                                        \
       syst.set_variation(var_name, variation(var_name).operator op_symbol(     \
                                        b.variation(var_name)));                \
     }                                                                          \
@@ -163,6 +171,10 @@
                           operator op_symbol())::action_type>>(                \
         this->nominal().operator op_symbol());                                 \
     for (auto const &var_name : systematic::get_variation_names(*this)) {      \
+      if (systematic::is_nominal(var_name, *this)) {                           \
+        syst.share_nominal(var_name);                                          \
+        continue;                                                              \
+      }                                                                        \
       syst.set_variation(var_name, variation(var_name).operator op_symbol());  \
     }                                                                          \
     return syst;                                                               \
@@ -172,6 +184,11 @@ namespace queryosity {
 
 template <typename T> class lazy;
 template <typename T> class todo;
+template <typename T> class varied;
+
+namespace column {
+template <typename T> class lane;
+}
 
 template <typename U>
 static constexpr std::true_type check_lazy(lazy<U> const &);
@@ -191,6 +208,20 @@ static constexpr bool has_no_variation_v = (is_nominal_v<Args> && ...);
 template <typename... Args>
 static constexpr bool has_variation_v = (is_varied_v<Args> || ...);
 
+template <typename U>
+static constexpr std::true_type
+check_vectorized(varied<lazy<column::lane<U>>> const &);
+static constexpr std::false_type check_vectorized(...) {
+  return std::false_type{};
+}
+
+template <typename V>
+static constexpr bool is_vectorized_v =
+    decltype(check_vectorized(std::declval<V>()))::value;
+
+template <typename... Args>
+static constexpr bool has_vectorized_variation_v = (is_vectorized_v<Args> || ...);
+
 namespace detail {
 
 // https://quuxplusone.github.io/blog/2021/07/09/priority-tag/
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <future>
 #include <iostream>
 #include <memory>
 #include <set>
@@ -205,6 +206,42 @@ public:
       std::enable_if_t<queryosity::query::is_aggregation_v<V>, bool> = false>
   auto result() const -> decltype(std::declval<V>().result());
 
+  /**
+   * @brief (Process and) retrieve the fraction of the dataset entries that
+   * went into the result of a query.
+   * @details Less than unity if the dataset was sampled, or its processing
+   * stopped early (e.g. upon running out of its time budget).
+   */
+  template <
+      typename V = Action,
+      std::enable_if_t<queryosity::query::is_aggregation_v<V>, bool> = false>
+  double fraction() const;
+
+  /**
+   * @brief Merge the results of a query counted so far.
+   * @return Query result.
+   * @details With windowed processing, the results as of the end of the latest
+   * window (see `dataflow::on_window()`).
+   * @attention Otherwise, only valid while the dataset is not being processed.
+   */
+  template <
+      typename V = Action,
+      std::enable_if_t<queryosity::query::is_aggregation_v<V>, bool> = false>
+  auto snapshot() const -> decltype(std::declval<V>().result());
+
+  /**
+   * @brief Retrieve the result of a query once the dataset has been processed
+   * in the background.
+   * @return Future query result.
+   * @details The dataset processing is started (see
+   * `dataflow::analyze_async()`) if it is not already in progress.
+   */
+  template <
+      typename V = Action,
+      std::enable_if_t<queryosity::query::is_aggregation_v<V>, bool> = false>
+  auto result_async() const
+      -> std::future<decltype(std::declval<V>().result())>;
+
   /**
    * @brief Shortcut for `result()`.
    */
@@ -370,6 +407,10 @@ auto queryosity::lazy<Action>::filter(Col const &col) const {
     using varied_type = varied<lazy<selection::node>>;
     auto syst = varied_type(this->filter(col.nominal()));
     for (auto const &var_name : col.get_variation_names()) {
+      if (systematic::is_nominal(var_name, col)) {
+        syst.share_nominal(var_name);
+        continue;
+      }
       syst.set_variation(var_name, this->filter(col.variation(var_name)));
     }
     return syst;
@@ -386,6 +427,10 @@ auto queryosity::lazy<Action>::weight(Col const &col) const {
     using varied_type = varied<lazy<selection::node>>;
     auto syst = varied_type(this->weight(col.nominal()));
     for (auto const &var_name : col.get_variation_names()) {
+      if (systematic::is_nominal(var_name, col)) {
+        syst.share_nominal(var_name);
+        continue;
+      }
       syst.set_variation(var_name, this->weight(col.variation(var_name)));
     }
     return syst;
@@ -496,6 +541,46 @@ auto queryosity::lazy<Action>::result() const
   return this->m_result;
 }
 
+template <typename Action>
+template <typename V,
+          std::enable_if_t<queryosity::query::is_aggregation_v<V>, bool>>
+double queryosity::lazy<Action>::fraction() const {
+  this->m_df->analyze();
+  return this->get_slot(0)->get_fraction();
+}
+
+template <typename Action>
+template <typename V,
+          std::enable_if_t<queryosity::query::is_aggregation_v<V>, bool>>
+auto queryosity::lazy<Action>::snapshot() const
+    -> decltype(std::declval<V>().result()) {
+  // merged at the end of the latest window, while all slots were on hold
+  auto const &snapshot = this->get_slot(0)->get_snapshot();
+  if (snapshot)
+    return *snapshot;
+  // always merged, so the snapshot is independent of the query afterwards
+  using result_type = decltype(this->get_slot(0)->result());
+  std::vector<result_type> results;
+  results.reserve(this->size());
+  for (size_t islot = 0; islot < this->size(); ++islot) {
+    results.push_back(this->get_slot(islot)->result());
+  }
+  return this->get_slot(0)->merge(results);
+}
+
+template <typename Action>
+template <typename V,
+          std::enable_if_t<queryosity::query::is_aggregation_v<V>, bool>>
+auto queryosity::lazy<Action>::result_async() const
+    -> std::future<decltype(std::declval<V>().result())> {
+  auto analysis = this->m_df->analyze_async();
+  return std::async(std::launch::async, [analysis, lzy = *this]() {
+    analysis.get();
+    lzy.merge_results();
+    return lzy.m_result;
+  });
+}
+
 template <typename Action>
 template <typename V,
           std::enable_if_t<queryosity::query::is_aggregation_v<V>, bool> e>
@@ -505,14 +590,17 @@ void queryosity::lazy<Action>::merge_results() const {
   auto model = this->get_slot(0);
   using result_type = decltype(model->result());
   const auto nslots = this->size();
-  if (nslots == 1) {
+  // (along with the results received from worker processes, if any)
+  auto const &received = model->get_received();
+  if (nslots == 1 && !received.size()) {
     this->m_result = model->result();
   } else {
     std::vector<result_type> results;
-    results.reserve(nslots);
+    results.reserve(nslots + received.size());
     for (size_t islot = 0; islot < nslots; ++islot) {
       results.push_back(std::move(this->get_slot(islot)->result()));
     }
+    results.insert(results.end(), received.begin(), received.end());
     this->m_result = model->merge(results);
   }
   this->m_merged = true;
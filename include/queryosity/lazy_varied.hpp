@@ -48,6 +48,14 @@ public:
   virtual void set_variation(const std::string &variation_name,
                              lazy<Act> var) final override;
 
+  /**
+   * @brief Register a variation under which the action remains nominal.
+   * @param[in] variation_name Variation name.
+   * @details The nominal action is shared by the variation, instead of being
+   * instantiated separately for it.
+   */
+  void share_nominal(const std::string &variation_name);
+
   virtual lazy<Act> &nominal() final override;
   virtual lazy<Act> &
   variation(const std::string &variation_name) final override;
@@ -161,12 +169,22 @@ queryosity::varied<queryosity::lazy<Act>>::operator=(
 template <typename Act>
 void queryosity::varied<queryosity::lazy<Act>>::set_variation(
     const std::string &variation_name, queryosity::lazy<Act> var) {
+  if (var.get_slots() == m_nominal.get_slots()) {
+    this->share_nominal(variation_name);
+    return;
+  }
   dataflow::node::invoke(
       [variation_name](action *act) { act->vary(variation_name); }, var);
   m_variation_map.insert(std::make_pair(variation_name, std::move(var)));
   m_variation_names.insert(variation_name);
 }
 
+template <typename Act>
+void queryosity::varied<queryosity::lazy<Act>>::share_nominal(
+    const std::string &variation_name) {
+  m_variation_names.insert(variation_name);
+}
+
 template <typename Act>
 auto queryosity::varied<queryosity::lazy<Act>>::nominal()
     -> queryosity::lazy<Act> & {
@@ -176,9 +194,8 @@ auto queryosity::varied<queryosity::lazy<Act>>::nominal()
 template <typename Act>
 auto queryosity::varied<queryosity::lazy<Act>>::variation(
     const std::string &variation_name) -> queryosity::lazy<Act> & {
-  return (this->has_variation(variation_name)
-              ? m_variation_map.at(variation_name)
-              : m_nominal);
+  auto var = m_variation_map.find(variation_name);
+  return var != m_variation_map.end() ? var->second : m_nominal;
 }
 
 template <typename Act>
@@ -190,15 +207,14 @@ auto queryosity::varied<queryosity::lazy<Act>>::nominal() const
 template <typename Act>
 auto queryosity::varied<queryosity::lazy<Act>>::variation(
     const std::string &variation_name) const -> queryosity::lazy<Act> const & {
-  return (this->has_variation(variation_name)
-              ? m_variation_map.at(variation_name)
-              : m_nominal);
+  auto var = m_variation_map.find(variation_name);
+  return var != m_variation_map.end() ? var->second : m_nominal;
 }
 
 template <typename Act>
 bool queryosity::varied<queryosity::lazy<Act>>::has_variation(
     const std::string &variation_name) const {
-  return m_variation_map.find(variation_name) != m_variation_map.end();
+  return m_variation_names.find(variation_name) != m_variation_names.end();
 }
 
 template <typename Act>
@@ -219,6 +235,10 @@ auto queryosity::varied<queryosity::lazy<Act>>::filter(Col const &col)
 
   for (auto const &variation_name :
        systematic::get_variation_names(*this, col)) {
+    if (systematic::is_nominal(variation_name, *this, col)) {
+      syst.share_nominal(variation_name);
+      continue;
+    }
     syst.set_variation(
         variation_name,
         this->variation(variation_name).filter(col.variation(variation_name)));
@@ -238,6 +258,10 @@ auto queryosity::varied<queryosity::lazy<Act>>::weight(Col const &col)
 
   for (auto const &variation_name :
        systematic::get_variation_names(*this, col)) {
+    if (systematic::is_nominal(variation_name, *this, col)) {
+      syst.share_nominal(variation_name);
+      continue;
+    }
     syst.set_variation(
         variation_name,
         this->variation(variation_name).weight(col.variation(variation_name)));
@@ -259,6 +283,10 @@ auto queryosity::varied<queryosity::lazy<Act>>::filter(
   auto syst = varied_type(this->nominal().filter(expr));
 
   for (auto const &variation_name : systematic::get_variation_names(*this)) {
+    if (systematic::is_nominal(variation_name, *this)) {
+      syst.share_nominal(variation_name);
+      continue;
+    }
     syst.set_variation(variation_name,
                        this->variation(variation_name).filter(expr));
   }
@@ -279,6 +307,10 @@ auto queryosity::varied<queryosity::lazy<Act>>::weight(
   auto syst = varied_type(this->nominal().weight(expr));
 
   for (auto const &variation_name : systematic::get_variation_names(*this)) {
+    if (systematic::is_nominal(variation_name, *this)) {
+      syst.share_nominal(variation_name);
+      continue;
+    }
     syst.set_variation(variation_name,
                        this->variation(variation_name).weight(expr));
   }
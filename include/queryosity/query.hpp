@@ -1,7 +1,9 @@
 #pragma once
 
 #include <functional>
+#include <iosfwd>
 #include <set>
+#include <stdexcept>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -64,16 +66,116 @@ public:
   void set_selection(const selection::node &selection);
   const selection::node *get_selection() const;
 
+  /**
+   * @brief Count a variation of this query alongside it.
+   * @param[in] var Query of the same type, filled with the same columns, and
+   * booked at a variation of the selection.
+   * @details The variation is no longer executed on its own: instead, this
+   * query counts an entry once for itself and all of its variations whose
+   * selections have passed, each with their own weight.
+   */
+  void add_variation(query::node &var);
+
+  /**
+   * @brief Get the nominal query that this query is counted alongside.
+   * @return Nominal query, or `nullptr` if this query is counted on its own.
+   */
+  query::node const *get_nominal() const;
+
+  /**
+   * @brief Check whether the query has been fully performed.
+   * @details Once all queries in a thread slot are done, the slot stops
+   * processing the dataset (after finalizing the part in progress).
+   */
+  bool is_done() const;
+
+  /**
+   * @brief Keep track of the number of queries that are yet to be done.
+   * @param[in] pending Counter decremented when this query is done.
+   */
+  void set_pending(unsigned int *pending);
+
+  /**
+   * @brief Fraction of the dataset entries that went into the query.
+   * @details Set once the processing that the query was performed in is over.
+   */
+  double get_fraction() const;
+  void set_fraction(double fraction);
+
   virtual void initialize(unsigned int slot, unsigned long long begin,
                           unsigned long long end) override;
-  virtual void execute(unsigned int slot, unsigned long long entry) final override;
+  virtual void execute(unsigned int slot, unsigned long long entry) override;
   virtual void finalize(unsigned int slot) override;
 
+  /**
+   * @brief Complete any counting that has been deferred.
+   * @details Called before `finalize()` at the end of each part of the
+   * dataset.
+   */
+  virtual void flush();
+
+  /**
+   * @brief Discard the entries counted so far.
+   * @details Called in-between the windows of a tumbling windowed processing
+   * (see `dataset::window`). Queries that do not implement it keep on
+   * accumulating their entries.
+   */
+  virtual void reset();
+
+  /**
+   * @brief Keep a copy of the results merged across thread slots.
+   * @param[in] slots Instances of this query in all thread slots.
+   * @param[in] nsteps Number of latest steps (of a sliding window) to merge
+   * the copy with.
+   * @details Called at the end of each processing window while all slots are
+   * on hold (see `dataset::window`).
+   */
+  virtual void snapshot(std::vector<query::node *> const &slots,
+                        unsigned int nsteps);
+
+  /**
+   * @brief Write the result of the query into a binary stream.
+   * @details Required to process the dataset with multiple processes (see
+   * `multiprocess::enable()`), each of which sends over its results to be
+   * merged.
+   */
+  virtual void serialize(std::ostream &out) const;
+
+  /**
+   * @brief Receive a result written by `serialize()` in another process.
+   */
+  virtual void deserialize(std::istream &in);
+
   virtual void count(double w) = 0;
 
+  /**
+   * @brief Count an entry for this query and its variations at once.
+   * @param[in] qrys This query and/or its variations that passed their
+   * selections.
+   * @param[in] ws Weight of each query.
+   * @details By default, each query is counted individually.
+   */
+  virtual void count_variations(std::vector<query::node *> const &qrys,
+                                std::vector<double> const &ws);
+
+protected:
+  /**
+   * @brief Signal that the query does not need to count any more entries.
+   */
+  void set_done();
+
 protected:
   double m_scale;
   const selection::node *m_selection;
+
+  query::node *m_nominal;
+  std::vector<query::node *> m_variations;
+  std::vector<query::node *> m_counted;
+  std::vector<double> m_weights;
+
+  bool m_done;
+  unsigned int *m_pending;
+  double m_fraction;
 };
 
 template <typename T>
@@ -122,7 +224,9 @@ protected:
 #include "column.hpp"
 #include "selection.hpp"
 
-inline queryosity::query::node::node() : m_scale(1.0), m_selection(nullptr) {}
+inline queryosity::query::node::node()
+    : m_scale(1.0), m_selection(nullptr), m_nominal(nullptr), m_done(false),
+      m_pending(nullptr), m_fraction(1.0) {}
 
 inline void
 queryosity::query::node::set_selection(const selection::node &selection) {
@@ -138,6 +242,46 @@ inline void queryosity::query::node::apply_scale(double scale) {
   m_scale *= scale;
 }
 
+inline void queryosity::query::node::add_variation(query::node &var) {
+  var.m_nominal = this;
+  m_variations.push_back(&var);
+}
+
+inline queryosity::query::node const *
+queryosity::query::node::get_nominal() const {
+  return m_nominal;
+}
+
+inline bool queryosity::query::node::is_done() const { return m_done; }
+
+inline void queryosity::query::node::set_pending(unsigned int *pending) {
+  m_pending = pending;
+}
+
+inline double queryosity::query::node::get_fraction() const {
+  return m_fraction;
+}
+
+inline void queryosity::query::node::set_fraction(double fraction) {
+  m_fraction = fraction;
+}
+
+inline void queryosity::query::node::set_done() {
+  if (m_done)
+    return;
+  m_done = true;
+  if (m_pending)
+    --(*m_pending);
+}
+
+inline void queryosity::query::node::serialize(std::ostream &) const {
+  throw std::logic_error("query result cannot be serialized");
+}
+
+inline void queryosity::query::node::deserialize(std::istream &) {
+  throw std::logic_error("query result cannot be deserialized");
+}
+
 inline void queryosity::query::node::initialize(unsigned int,
                                                 unsigned long long,
                                                 unsigned long long) {
@@ -146,9 +290,45 @@ inline void queryosity::query::node::initialize(unsigned int,
 }
 
 inline void queryosity::query::node::execute(unsigned int, unsigned long long) {
+  // counted alongside its nominal (or no longer needed, along with all of
+  // its variations)
+  if (m_nominal || (m_done && !m_variations.size()))
+    return;
+  if (!m_variations.size()) {
+    if (m_selection->passed_cut()) {
+      this->count(m_scale * m_selection->get_weight());
+    }
+    return;
+  }
+  m_counted.clear();
+  m_weights.clear();
   if (m_selection->passed_cut()) {
-    this->count(m_scale * m_selection->get_weight());
+    m_counted.push_back(this);
+    m_weights.push_back(m_scale * m_selection->get_weight());
+  }
+  for (auto const &var : m_variations) {
+    if (var->m_selection->passed_cut()) {
+      m_counted.push_back(var);
+      m_weights.push_back(var->m_scale * var->m_selection->get_weight());
+    }
+  }
+  if (m_counted.size())
+    this->count_variations(m_counted, m_weights);
+}
+
+inline void queryosity::query::node::count_variations(
+    std::vector<query::node *> const &qrys, std::vector<double> const &ws) {
+  for (unsigned int i = 0; i < qrys.size(); ++i) {
+    qrys[i]->count(ws[i]);
   }
 }
 
-inline void queryosity::query::node::finalize(unsigned int) {}
\ No newline at end of file
+inline void queryosity::query::node::finalize(unsigned int) {}
+
+inline void queryosity::query::node::flush() {}
+
+inline void queryosity::query::node::reset() {}
+
+inline void
+queryosity::query::node::snapshot(std::vector<query::node *> const &,
+                                  unsigned int) {}
\ No newline at end of file
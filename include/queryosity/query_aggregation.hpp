@@ -1,9 +1,35 @@
 #pragma once
 
+#include <deque>
+#include <istream>
+#include <optional>
+#include <ostream>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
 #include "query.hpp"
 
 namespace queryosity {
 
+namespace query {
+
+// results that can be written out byte-by-byte
+template <typename T>
+struct is_trivially_serializable
+    : std::conjunction<std::is_trivially_copyable<T>,
+                       std::negation<std::is_pointer<T>>> {};
+template <typename T>
+struct is_trivially_serializable<std::vector<T>>
+    : std::conjunction<is_trivially_serializable<T>,
+                       std::negation<std::is_same<T, bool>>> {};
+
+template <typename T>
+constexpr bool is_trivially_serializable_v =
+    is_trivially_serializable<T>::value;
+
+} // namespace query
+
 /**
  * @brief Minimal query with an output result.
  * @details This ABC should be used for actions that do not require any input
@@ -34,6 +60,23 @@ public:
    */
   virtual T merge(std::vector<T> const &results) const = 0;
 
+  virtual void snapshot(std::vector<node *> const &slots,
+                        unsigned int nsteps) override;
+
+  /**
+   * @brief Results merged at the end of the latest processing window, if any.
+   */
+  std::optional<T> const &get_snapshot() const;
+
+  virtual void serialize(std::ostream &out) const override;
+  virtual void deserialize(std::istream &in) override;
+
+  /**
+   * @brief Results received from other processes.
+   * @details They are merged along with the results of the thread slots.
+   */
+  std::vector<T> const &get_received() const;
+
   using node::count;
 
   /**
@@ -43,8 +86,106 @@ public:
   T operator->() const { return this->result(); }
 
 protected:
+  /**
+   * @brief Write a result into a binary stream.
+   * @details Trivially copyable results (and vectors thereof) are written
+   * as-is; any other result type must implement this (and `read()`) for the
+   * query to be processed with multiple processes.
+   */
+  virtual void write(std::ostream &out, T const &result) const;
+
+  /**
+   * @brief Read a result written by `write()` from a binary stream.
+   */
+  virtual T read(std::istream &in) const;
+
+protected:
+  std::optional<T> m_snapshot;
+  std::deque<T> m_steps;
+  std::vector<T> m_received;
 };
 
 } // namespace queryosity
 
-#include "selection.hpp"
\ No newline at end of file
+#include "selection.hpp"
+
+template <typename T>
+void queryosity::query::aggregation<T>::snapshot(
+    std::vector<node *> const &slots, unsigned int nsteps) {
+  std::vector<T> results;
+  results.reserve(slots.size());
+  for (auto const &slot : slots) {
+    results.push_back(static_cast<aggregation<T> *>(slot)->result());
+  }
+  if (nsteps <= 1) {
+    m_snapshot = this->merge(results);
+    return;
+  }
+  // sliding window: keep the latest steps around to be merged together
+  m_steps.push_back(this->merge(results));
+  while (m_steps.size() > nsteps) {
+    m_steps.pop_front();
+  }
+  m_snapshot = this->merge(std::vector<T>(m_steps.begin(), m_steps.end()));
+}
+
+template <typename T>
+std::optional<T> const &queryosity::query::aggregation<T>::get_snapshot() const {
+  return m_snapshot;
+}
+
+template <typename T>
+void queryosity::query::aggregation<T>::serialize(std::ostream &out) const {
+  this->write(out, this->result());
+  if (!out)
+    throw std::runtime_error("failed to write query result");
+}
+
+template <typename T>
+void queryosity::query::aggregation<T>::deserialize(std::istream &in) {
+  auto received = this->read(in);
+  if (!in)
+    throw std::runtime_error("failed to read query result");
+  m_received.push_back(std::move(received));
+}
+
+template <typename T>
+std::vector<T> const &queryosity::query::aggregation<T>::get_received() const {
+  return m_received;
+}
+
+template <typename T>
+void queryosity::query::aggregation<T>::write(std::ostream &out,
+                                              T const &result) const {
+  if constexpr (!is_trivially_serializable_v<T>) {
+    (void)out;
+    (void)result;
+    throw std::logic_error("query result cannot be serialized");
+  } else if constexpr (std::is_trivially_copyable_v<T>) {
+    out.write(reinterpret_cast<char const *>(&result), sizeof(T));
+  } else {
+    const unsigned long long size = result.size();
+    out.write(reinterpret_cast<char const *>(&size), sizeof(size));
+    out.write(reinterpret_cast<char const *>(result.data()),
+              size * sizeof(typename T::value_type));
+  }
+}
+
+template <typename T>
+T queryosity::query::aggregation<T>::read(std::istream &in) const {
+  if constexpr (!is_trivially_serializable_v<T>) {
+    (void)in;
+    throw std::logic_error("query result cannot be deserialized");
+  } else if constexpr (std::is_trivially_copyable_v<T>) {
+    T result;
+    in.read(reinterpret_cast<char *>(&result), sizeof(T));
+    return result;
+  } else {
+    unsigned long long size = 0;
+    in.read(reinterpret_cast<char *>(&size), sizeof(size));
+    T result(in ? size : 0);
+    in.read(reinterpret_cast<char *>(result.data()),
+            result.size() * sizeof(typename T::value_type));
+    return result;
+  }
+}
@@ -1,5 +1,9 @@
 #pragma once
 
+#include <tuple>
+#include <utility>
+#include <vector>
+
 #include "query.hpp"
 #include "query_aggregation.hpp"
 #include "query_fillable.hpp"
@@ -31,12 +35,75 @@ public:
    * the number of `fill()` calls made to its lazy node.
    */
   virtual void count(double w) final override;
+
+  /**
+   * @brief Perform the counting action for an entry, for this query and its
+   * variations at once.
+   * @details The input columns of the variations are identical to this
+   * query's, such that only their weights differ.
+   */
+  virtual void count_variations(std::vector<query::node *> const &qrys,
+                                std::vector<double> const &ws) final override;
+
+  /**
+   * @brief Fill this query and/or its variations with input columns.
+   * @param[in] observables Input column observables.
+   * @param[in] qrys Queries to be filled.
+   * @param[in] ws Weight of each query.
+   * @details By default, each query is filled individually. Queries can
+   * override this method to fill the same input column values with multiple
+   * weights more efficiently.
+   */
+  virtual void fill_variations(column::observable<Ins>... observables,
+                               std::vector<query::node *> const &qrys,
+                               std::vector<double> const &ws);
+
+  /**
+   * @brief Fill the query with a batch of entries at once.
+   * @param[in] columns Input column values of each entry.
+   * @param[in] weights Weight of each entry.
+   * @details Only called if the query has opted into batching (see
+   * `set_batch_size()`). By default, each entry is filled individually.
+   */
+  virtual void fill_batch(std::vector<Ins> const &...columns,
+                          std::vector<double> const &weights);
+
+  /**
+   * @brief Buffer the entries to be filled into batches.
+   * @param[in] size Number of entries per batch (`0` to fill each entry
+   * as it is counted).
+   * @details The buffered entries are filled through `fill_batch()` once
+   * the batch is full, and at the end of each part of the dataset.
+   * Variations counted alongside this query are still filled per-entry.
+   */
+  void set_batch_size(unsigned int size);
+
+  virtual void flush() override;
+
+protected:
+  template <std::size_t... Is>
+  void buffer(vartup_type const &fill, double w, std::index_sequence<Is...>);
+
+protected:
+  unsigned int m_batch_size = 0;
+  std::tuple<std::vector<Ins>...> m_batch;
+  std::vector<double> m_batch_weights;
 };
 
 } // namespace queryosity
 
+#include "column_fixed.hpp"
+
 template <typename Out, typename... Ins>
 void queryosity::query::definition<Out(Ins...)>::count(double w) {
+  if (m_batch_size) {
+    for (auto const &fill : this->m_fills) {
+      this->buffer(fill, w, std::index_sequence_for<Ins...>());
+    }
+    if (m_batch_weights.size() >= m_batch_size)
+      this->flush();
+    return;
+  }
   for (unsigned int ifill = 0; ifill < this->m_fills.size(); ++ifill) {
     std::apply(
         [this, w](const column::variable<Ins> &...obs) {
@@ -44,4 +111,69 @@ void queryosity::query::definition<Out(Ins...)>::count(double w) {
         },
         this->m_fills[ifill]);
   }
-}
\ No newline at end of file
+}
+
+template <typename Out, typename... Ins>
+void queryosity::query::definition<Out(Ins...)>::count_variations(
+    std::vector<query::node *> const &qrys, std::vector<double> const &ws) {
+  for (unsigned int ifill = 0; ifill < this->m_fills.size(); ++ifill) {
+    std::apply(
+        [this, &qrys, &ws](const column::variable<Ins> &...obs) {
+          this->fill_variations(obs..., qrys, ws);
+        },
+        this->m_fills[ifill]);
+  }
+}
+
+template <typename Out, typename... Ins>
+void queryosity::query::definition<Out(Ins...)>::fill_variations(
+    column::observable<Ins>... observables,
+    std::vector<query::node *> const &qrys, std::vector<double> const &ws) {
+  for (unsigned int i = 0; i < qrys.size(); ++i) {
+    static_cast<definition *>(qrys[i])->fill(observables..., ws[i]);
+  }
+}
+
+template <typename Out, typename... Ins>
+void queryosity::query::definition<Out(Ins...)>::fill_batch(
+    std::vector<Ins> const &...columns, std::vector<double> const &weights) {
+  for (unsigned int i = 0; i < weights.size(); ++i) {
+    std::tuple<column::fixed<Ins>...> values(columns[i]...);
+    std::apply(
+        [this, w = weights[i]](column::fixed<Ins> const &...vals) {
+          this->fill(column::variable<Ins>(vals)..., w);
+        },
+        values);
+  }
+}
+
+template <typename Out, typename... Ins>
+void queryosity::query::definition<Out(Ins...)>::set_batch_size(
+    unsigned int size) {
+  this->flush();
+  m_batch_size = size;
+  std::apply([size](std::vector<Ins> &...cols) { (cols.reserve(size), ...); },
+             m_batch);
+  m_batch_weights.reserve(size);
+}
+
+template <typename Out, typename... Ins>
+void queryosity::query::definition<Out(Ins...)>::flush() {
+  if (!m_batch_weights.size())
+    return;
+  std::apply(
+      [this](std::vector<Ins> const &...cols) {
+        this->fill_batch(cols..., m_batch_weights);
+      },
+      m_batch);
+  std::apply([](std::vector<Ins> &...cols) { (cols.clear(), ...); }, m_batch);
+  m_batch_weights.clear();
+}
+
+template <typename Out, typename... Ins>
+template <std::size_t... Is>
+void queryosity::query::definition<Out(Ins...)>::buffer(
+    vartup_type const &fill, double w, std::index_sequence<Is...>) {
+  (std::get<Is>(m_batch).push_back(std::get<Is>(fill).value()), ...);
+  m_batch_weights.push_back(w);
+}
@@ -23,11 +23,20 @@ public:
   template <typename Qry>
   auto book(query::booker<Qry> const &bkr, const selection::node &sel) -> Qry *;
 
+protected:
+  using execute_t = void (*)(action *, unsigned int, unsigned long long);
+
 protected:
   template <typename Qry> auto add_query(std::unique_ptr<Qry> qry) -> Qry *;
 
+  // execute a query through its concrete type (without virtual dispatch)
+  template <typename Qry>
+  static void execute_query(action *qry, unsigned int slot,
+                            unsigned long long entry);
+
 protected:
   std::vector<query::node *> m_queries;
+  std::vector<execute_t> m_executes;
   std::vector<std::unique_ptr<query::node>> m_queries_history;
 };
 
@@ -53,5 +62,13 @@ auto queryosity::query::experiment::add_query(std::unique_ptr<Qry> qry)
   auto out = qry.get();
   m_queries_history.push_back(std::move(qry));
   m_queries.push_back(m_queries_history.back().get());
+  m_executes.push_back(&experiment::execute_query<Qry>);
   return out;
+}
+
+template <typename Qry>
+void queryosity::query::experiment::execute_query(action *qry,
+                                                  unsigned int slot,
+                                                  unsigned long long entry) {
+  static_cast<Qry *>(qry)->Qry::execute(slot, entry);
 }
\ No newline at end of file
@@ -2,6 +2,8 @@
 
 #include "query_definition.hpp"
 
+#include <algorithm>
+#include <limits>
 #include <vector>
 
 namespace queryosity
@@ -14,32 +16,47 @@ template <typename T> class series : public queryosity::query::definition<std::v
 {
 
   public:
-    series() = default;
+    /**
+     * @brief Constructor.
+     * @param[in] limit Maximum number of entries in the series.
+     * @details The query is done once it has been filled up to its limit.
+     */
+    series(unsigned long long limit = std::numeric_limits<unsigned long long>::max());
     ~series() = default;
 
     virtual void initialize(unsigned int, unsigned long long, unsigned long long) final override;
     virtual void fill(column::observable<T>, double) final override;
     virtual void finalize(unsigned int) final override;
+    virtual void reset() final override;
     virtual std::vector<T> result() const final override;
     virtual std::vector<T> merge(std::vector<std::vector<T>> const &results) const final override;
 
   protected:
     std::vector<T> m_result;
+    unsigned long long m_limit;
 };
 
 } // namespace query
 
 } // namespace queryosity
 
+template <typename T> queryosity::query::series<T>::series(unsigned long long limit) : m_limit(limit)
+{
+}
+
 template <typename T>
 void queryosity::query::series<T>::initialize(unsigned int, unsigned long long begin, unsigned long long end)
 {
-    m_result.reserve(end - begin);
+    m_result.reserve(std::min(end - begin, m_limit));
 }
 
 template <typename T> void queryosity::query::series<T>::fill(column::observable<T> x, double)
 {
+    if (m_result.size() >= m_limit)
+        return;
     m_result.push_back(x.value());
+    if (m_result.size() >= m_limit)
+        this->set_done();
 }
 
 template <typename T> void queryosity::query::series<T>::finalize(unsigned int)
@@ -47,6 +64,11 @@ template <typename T> void queryosity::query::series<T>::finalize(unsigned int)
     m_result.resize(m_result.size());
 }
 
+template <typename T> void queryosity::query::series<T>::reset()
+{
+    m_result.clear();
+}
+
 template <typename T> std::vector<T> queryosity::query::series<T>::result() const
 {
     return m_result;
@@ -66,5 +88,8 @@ std::vector<T> queryosity::query::series<T>::merge(std::vector<std::vector<T>> c
     {
         merged.insert(merged.end(), result.begin(), result.end());
     }
+    // each slot is filled up to the limit
+    if (merged.size() > m_limit)
+        merged.resize(m_limit);
     return merged;
 }
\ No newline at end of file
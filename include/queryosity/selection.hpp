@@ -26,6 +26,8 @@ struct count_t;
 
 class counter;
 
+class tally;
+
 template <typename... Ts> struct yield;
 
 class node : public column::calculation<double> {
@@ -49,6 +51,15 @@ public:
 protected:
   const selection::node *const m_preselection;
   column::variable<double> m_decision;
+
+  // nearest cut & weight strictly upstream of this selection, whose (cached)
+  // values are the cumulative decision & weight up to them
+  const selection::node *m_previous_cut;
+  const selection::node *m_previous_weight;
+
+  // nearest cut & weight up to and including this selection
+  const selection::node *m_cut;
+  const selection::node *m_weight;
 };
 
 template <typename T> struct is_applicable : std::false_type {};
@@ -71,7 +82,10 @@ constexpr bool is_selection_v = std::is_base_of_v<selection::node, T>;
 
 inline queryosity::selection::node::node(const selection::node *presel,
                                          column::variable<double> dec)
-    : m_preselection(presel), m_decision(std::move(dec)) {}
+    : m_preselection(presel), m_decision(std::move(dec)),
+      m_previous_cut(presel ? presel->m_cut : nullptr),
+      m_previous_weight(presel ? presel->m_weight : nullptr),
+      m_cut(m_previous_cut), m_weight(m_previous_weight) {}
 
 inline bool queryosity::selection::node::is_initial() const noexcept {
   return m_preselection ? false : true;
@@ -20,18 +20,19 @@ public:
 
 inline queryosity::selection::cut::cut(const selection::node *presel,
                                        column::variable<double> dec)
-    : selection::node(presel, std::move(dec)) {}
+    : selection::node(presel, std::move(dec)) {
+  m_cut = this;
+}
 
 inline double queryosity::selection::cut::calculate() const {
-  return this->passed_cut();
+  return m_previous_cut ? m_previous_cut->value() && m_decision.value()
+                        : m_decision.value();
 }
 
 inline bool queryosity::selection::cut::passed_cut() const {
-  return this->m_preselection
-             ? this->m_preselection->passed_cut() && m_decision.value()
-             : m_decision.value();
+  return this->value();
 }
 
 inline double queryosity::selection::cut::get_weight() const {
-  return this->m_preselection ? this->m_preselection->get_weight() : 1.0;
+  return m_previous_weight ? m_previous_weight->value() : 1.0;
 }
\ No newline at end of file
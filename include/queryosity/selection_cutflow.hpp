@@ -21,10 +21,9 @@ public:
   auto apply(selection::node const *prev, column::valued<Val> const &dec)
       -> selection::node *;
 
-  template <typename Sel, typename Ret, typename... Args>
-  auto select(selection::node const *prev, std::function<Ret(Args...)> fn) const
-      -> std::unique_ptr<applicator<
-          Sel, column::equation<std::decay_t<Ret>(std::decay_t<Args>...)>>>;
+  template <typename Sel, typename Fn>
+  auto select(selection::node const *prev, Fn fn) const
+      -> std::unique_ptr<applicator<Sel, column::equation_t<Fn>>>;
 
   template <typename Sel, typename Def>
   auto select(selection::node const *prev, std::unique_ptr<column::evaluator<Def>> eval) const
@@ -56,14 +55,11 @@ auto queryosity::selection::cutflow::apply(selection::node const *prev,
   return this->add_selection(std::move(sel));
 }
 
-template <typename Sel, typename Ret, typename... Args>
-auto queryosity::selection::cutflow::select(
-    selection::node const *prev, std::function<Ret(Args...)> fn) const
-    -> std::unique_ptr<applicator<
-        Sel, column::equation<std::decay_t<Ret>(std::decay_t<Args>...)>>> {
-  return std::make_unique<applicator<
-      Sel, column::equation<std::decay_t<Ret>(std::decay_t<Args>...)>>>(prev,
-                                                                        fn);
+template <typename Sel, typename Fn>
+auto queryosity::selection::cutflow::select(selection::node const *prev,
+                                            Fn fn) const
+    -> std::unique_ptr<applicator<Sel, column::equation_t<Fn>>> {
+  return std::make_unique<applicator<Sel, column::equation_t<Fn>>>(prev, fn);
 }
 
 template <typename Sel, typename Def>
@@ -85,6 +81,7 @@ template <typename Sel>
 auto queryosity::selection::cutflow::add_selection(std::unique_ptr<Sel> sel)
     -> Sel * {
   auto out = sel.get();
+  out->set_cursor(&m_cursor);
   m_selections.push_back(std::move(sel));
   return out;
 }
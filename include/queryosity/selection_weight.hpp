@@ -23,18 +23,19 @@ public:
 
 inline queryosity::selection::weight::weight(const selection::node *presel,
                                              column::variable<double> dec)
-    : selection::node(presel, std::move(dec)) {}
+    : selection::node(presel, std::move(dec)) {
+  m_weight = this;
+}
 
 inline double queryosity::selection::weight::calculate() const {
-  return this->get_weight();
+  return m_previous_weight ? m_previous_weight->value() * m_decision.value()
+                           : m_decision.value();
 }
 
 inline bool queryosity::selection::weight::passed_cut() const {
-  return this->m_preselection ? this->m_preselection->passed_cut() : true;
+  return m_previous_cut ? m_previous_cut->value() : true;
 }
 
 inline double queryosity::selection::weight::get_weight() const {
-  return this->m_preselection
-             ? this->m_preselection->get_weight() * m_decision.value()
-             : m_decision.value();
+  return this->value();
 }
\ No newline at end of file
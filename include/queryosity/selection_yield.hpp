@@ -5,7 +5,11 @@
 #include "query_output.hpp"
 #include "selection.hpp"
 
+#include <algorithm>
 #include <cmath>
+#include <functional>
+#include <stdexcept>
+#include <vector>
 
 namespace queryosity {
 
@@ -29,13 +33,56 @@ public:
 
   virtual void count(double w) final override;
   virtual count_t result() const final override;
-  virtual void finalize(unsigned int) final override;
+  virtual void reset() final override;
   virtual count_t merge(std::vector<count_t> const &results) const final override;
 
 protected:
+  // error as the sum of weights squared
   count_t m_cnt;
 };
 
+/**
+ * @brief Yields of many selections counted by a single query.
+ * @details The selections are arranged into a tree by their preselections,
+ * which is walked top-down for each entry: the descendants of a selection that
+ * failed are not checked at all.
+ */
+class tally : public query::aggregation<std::vector<count_t>> {
+
+public:
+  tally() = default;
+  virtual ~tally() = default;
+
+  /**
+   * @brief Add a selection to be counted.
+   * @param[in] sel Selection node.
+   */
+  void add_selection(selection::node const &sel);
+
+  virtual void initialize(unsigned int slot, unsigned long long begin,
+                          unsigned long long end) final override;
+  virtual void execute(unsigned int slot,
+                       unsigned long long entry) final override;
+  virtual void count(double w) final override;
+  virtual std::vector<count_t> result() const final override;
+  virtual void reset() final override;
+  virtual std::vector<count_t>
+  merge(std::vector<std::vector<count_t>> const &results) const final override;
+
+protected:
+  struct branch {
+    selection::node const *selection;
+    unsigned int index; // of the selection as added
+    unsigned int end;   // of its subtree in the walk
+  };
+
+protected:
+  std::vector<selection::node const *> m_selections;
+  std::vector<branch> m_walk;
+  // errors as the sums of weights squared
+  std::vector<count_t> m_counts;
+};
+
 /**
  * @brief Argumnet for column yield.
  * @tparam Sel (Varied) lazy column node.
@@ -53,6 +100,23 @@ protected:
   std::tuple<Sels...> m_selections;
 };
 
+/**
+ * @brief Argument for the yields of an arbitrary number of selections.
+ * @tparam Sel Lazy selection node.
+ * @details The yields are counted by a single `selection::tally` query.
+ */
+template <typename Sel> struct yield<std::vector<Sel>> {
+
+public:
+  yield(std::vector<Sel> const &sels);
+  ~yield() = default;
+
+  auto make(dataflow &df) const;
+
+protected:
+  std::vector<Sel> m_selections;
+};
+
 } // namespace selection
 
 } // namespace queryosity
@@ -63,17 +127,17 @@ inline void queryosity::selection::counter::count(double w) {
   m_cnt.error += w * w;
 }
 
-inline void queryosity::selection::counter::finalize(unsigned int) {
-  m_cnt.error = std::sqrt(m_cnt.error);
-}
-
 inline queryosity::selection::count_t queryosity::selection::counter::result() const {
-  return m_cnt;
+  auto cnt = m_cnt;
+  cnt.error = std::sqrt(cnt.error);
+  return cnt;
 }
 
+inline void queryosity::selection::counter::reset() { m_cnt = count_t{}; }
+
 inline queryosity::selection::count_t
 queryosity::selection::counter::merge(std::vector<count_t> const& cnts) const {
-  count_t sum;
+  count_t sum{};
   for (auto const &cnt : cnts) {
     sum.entries += cnt.entries;
     sum.value += cnt.value;
@@ -83,6 +147,101 @@ queryosity::selection::counter::merge(std::vector<count_t> const& cnts) const {
   return sum;
 }
 
+inline void
+queryosity::selection::tally::add_selection(selection::node const &sel) {
+  m_selections.push_back(&sel);
+  m_walk.clear();
+}
+
+inline void queryosity::selection::tally::initialize(unsigned int slot,
+                                                     unsigned long long begin,
+                                                     unsigned long long end) {
+  query::node::initialize(slot, begin, end);
+  m_counts.resize(m_selections.size(), count_t{});
+  if (m_walk.size() == m_selections.size())
+    return;
+
+  // nearest counted ancestor of each selection
+  auto nsels = m_selections.size();
+  std::vector<std::vector<unsigned int>> children(nsels + 1);
+  for (unsigned int i = 0; i < nsels; ++i) {
+    unsigned int parent = nsels;
+    for (auto prev = m_selections[i]->get_previous(); prev && parent == nsels;
+         prev = prev->get_previous()) {
+      for (unsigned int j = 0; j < nsels; ++j) {
+        if (m_selections[j] == prev) {
+          parent = j;
+          break;
+        }
+      }
+    }
+    children[parent].push_back(i);
+  }
+
+  // depth-first order, with the extent of each subtree
+  m_walk.clear();
+  std::function<void(unsigned int)> descend = [&](unsigned int i) {
+    auto at = m_walk.size();
+    m_walk.push_back({m_selections[i], i, 0});
+    for (auto child : children[i]) {
+      descend(child);
+    }
+    m_walk[at].end = m_walk.size();
+  };
+  for (auto root : children[nsels]) {
+    descend(root);
+  }
+}
+
+inline void queryosity::selection::tally::execute(unsigned int,
+                                                  unsigned long long) {
+  for (unsigned int i = 0; i < m_walk.size();) {
+    auto const &brn = m_walk[i];
+    if (!brn.selection->passed_cut()) {
+      i = brn.end;
+      continue;
+    }
+    auto w = m_scale * brn.selection->get_weight();
+    auto &cnt = m_counts[brn.index];
+    cnt.entries++;
+    cnt.value += w;
+    cnt.error += w * w;
+    ++i;
+  }
+}
+
+inline void queryosity::selection::tally::count(double) {}
+
+inline std::vector<queryosity::selection::count_t>
+queryosity::selection::tally::result() const {
+  auto cnts = m_counts;
+  for (auto &cnt : cnts) {
+    cnt.error = std::sqrt(cnt.error);
+  }
+  return cnts;
+}
+
+inline void queryosity::selection::tally::reset() {
+  std::fill(m_counts.begin(), m_counts.end(), count_t{});
+}
+
+inline std::vector<queryosity::selection::count_t>
+queryosity::selection::tally::merge(
+    std::vector<std::vector<count_t>> const &results) const {
+  std::vector<count_t> sum(m_selections.size(), count_t{});
+  for (auto const &cnts : results) {
+    for (unsigned int i = 0; i < cnts.size(); ++i) {
+      sum[i].entries += cnts[i].entries;
+      sum[i].value += cnts[i].value;
+      sum[i].error += cnts[i].error * cnts[i].error;
+    }
+  }
+  for (auto &cnt : sum) {
+    cnt.error = std::sqrt(cnt.error);
+  }
+  return sum;
+}
+
 template <typename... Sels>
 queryosity::selection::yield<Sels...>::yield(Sels const &...sels)
     : m_selections(sels...) {}
@@ -94,4 +253,23 @@ auto queryosity::selection::yield<Sels...>::make(dataflow &df) const {
         return df.get(query::output<counter>()).at(sels...);
       },
       m_selections);
-}
\ No newline at end of file
+}
+
+template <typename Sel>
+queryosity::selection::yield<std::vector<Sel>>::yield(
+    std::vector<Sel> const &sels)
+    : m_selections(sels) {}
+
+template <typename Sel>
+auto queryosity::selection::yield<std::vector<Sel>>::make(dataflow &df) const {
+  if (m_selections.empty())
+    throw std::runtime_error("no selections to yield");
+  // booked once, at the first selection, and counts all of them
+  auto tly = df.get(query::output<tally>()).at(m_selections.front());
+  for (auto const &sel : m_selections) {
+    dataflow::node::invoke(
+        [](tally *tly, selection::node const *sel) { tly->add_selection(*sel); },
+        tly, sel);
+  }
+  return tly;
+}
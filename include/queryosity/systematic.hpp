@@ -13,6 +13,9 @@ namespace systematic {
 template <typename... Nodes>
 auto get_variation_names(Nodes const &...nodes) -> std::set<std::string>;
 
+template <typename... Nodes>
+bool is_nominal(const std::string &var_name, Nodes const &...nodes);
+
 template <typename Node> class resolver;
 
 } // namespace systematic
@@ -25,4 +28,16 @@ auto queryosity::systematic::get_variation_names(Nodes const &...nodes)
   std::set<std::string> variation_names;
   (variation_names.merge(nodes.get_variation_names()), ...);
   return variation_names;
+}
+
+/**
+ * @brief Check whether nodes all remain nominal under a variation.
+ * @details An action that only depends on such nodes does not need to be
+ * instantiated separately for the variation, as it is identical to the
+ * nominal.
+ */
+template <typename... Nodes>
+bool queryosity::systematic::is_nominal(const std::string &var_name,
+                                        Nodes const &...nodes) {
+  return ((&nodes.variation(var_name) == &nodes.nominal()) && ...);
 }
\ No newline at end of file
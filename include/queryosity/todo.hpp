@@ -131,7 +131,9 @@ protected:
 
   template <typename... Nodes, typename V = Helper,
             std::enable_if_t<queryosity::column::is_evaluatable_v<V> &&
-                                 queryosity::has_variation_v<Nodes...>,
+                                 queryosity::has_variation_v<Nodes...> &&
+                                 !queryosity::has_vectorized_variation_v<
+                                     Nodes...>,
                              bool> = false>
   auto _evaluate(Nodes const &...columns) const
       -> varied<lazy<column::evaluated_t<V>>> {
@@ -143,6 +145,10 @@ protected:
     auto sys = varied_type(std::move(nom));
 
     for (auto const &var_name : systematic::get_variation_names(columns...)) {
+      if (systematic::is_nominal(var_name, columns...)) {
+        sys.share_nominal(var_name);
+        continue;
+      }
       auto var = this->m_df->_evaluate(*this, columns.variation(var_name)...);
       sys.set_variation(var_name, std::move(var));
     }
@@ -150,6 +156,17 @@ protected:
     return sys;
   }
 
+  template <typename... Nodes, typename V = Helper,
+            std::enable_if_t<queryosity::column::is_evaluatable_v<V> &&
+                                 queryosity::has_vectorized_variation_v<
+                                     Nodes...>,
+                             bool> = false>
+  auto _evaluate(Nodes const &...columns) const -> varied<
+      lazy<column::lane<column::value_t<column::evaluated_t<V>>>>> {
+    // all lanes evaluated at once by a single definition instance
+    return this->m_df->_evaluate_lanes(*this, columns...);
+  }
+
   template <typename... Nodes, typename V = Helper,
             std::enable_if_t<queryosity::selection::is_applicable_v<V> &&
                                  queryosity::has_no_variation_v<Nodes...>,
@@ -173,6 +190,10 @@ protected:
     auto sys = varied_type(nom);
 
     for (auto const &var_name : systematic::get_variation_names(columns...)) {
+      if (systematic::is_nominal(var_name, columns...)) {
+        sys.share_nominal(var_name);
+        continue;
+      }
       auto var = this->m_df->template _apply<selection_type>(
           *this, columns.variation(var_name)...);
       sys.set_variation(var_name, var);
@@ -197,8 +218,13 @@ protected:
     using varied_type = varied<lazy<query::booked_t<V>>>;
     auto sys = varied_type(this->m_df->_book(*this, sel.nominal()));
     for (auto const &var_name : systematic::get_variation_names(sel)) {
-      sys.set_variation(var_name,
-                         this->m_df->_book(*this, sel.variation(var_name)));
+      if (systematic::is_nominal(var_name, sel)) {
+        sys.share_nominal(var_name);
+        continue;
+      }
+      sys.set_variation(var_name, this->m_df->_book_variation(
+                                      *this, sel.variation(var_name),
+                                      sys.nominal()));
     }
     return sys;
   }
@@ -227,8 +253,13 @@ protected:
          this](systematic::resolver<lazy<selection::node>> const &sel) {
           auto sys = varied_type(this->m_df->_book(*this, sel.nominal()));
           for (auto const &var_name : var_names) {
-            sys.set_variation(
-                var_name, this->m_df->_book(*this, sel.variation(var_name)));
+            if (systematic::is_nominal(var_name, sel)) {
+              sys.share_nominal(var_name);
+              continue;
+            }
+            sys.set_variation(var_name, this->m_df->_book_variation(
+                                            *this, sel.variation(var_name),
+                                            sys.nominal()));
           }
           return sys;
         };
@@ -256,6 +287,10 @@ protected:
     using varied_type = varied<todo<V>>;
     auto sys = varied_type(std::move(this->_fill(columns.nominal()...)));
     for (auto const &var_name : systematic::get_variation_names(columns...)) {
+      if (systematic::is_nominal(var_name, columns...)) {
+        sys.share_nominal(var_name);
+        continue;
+      }
       sys.set_variation(
           var_name, std::move(this->_fill(columns.variation(var_name)...)));
     }
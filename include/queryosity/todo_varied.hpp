@@ -29,6 +29,12 @@ public:
   virtual void set_variation(const std::string &var_name,
                              todo<Helper> var) final override;
 
+  /**
+   * @brief Register a variation under which the todo item remains nominal.
+   * @param[in] var_name Variation name.
+   */
+  void share_nominal(const std::string &var_name);
+
   virtual todo<Helper> &nominal() final override;
   virtual todo<Helper> &variation(const std::string &var_name) final override;
   virtual todo<Helper> const &nominal() const final override;
@@ -107,6 +113,12 @@ void queryosity::varied<queryosity::todo<Helper>>::set_variation(
   m_variation_names.insert(var_name);
 }
 
+template <typename Helper>
+void queryosity::varied<queryosity::todo<Helper>>::share_nominal(
+    const std::string &var_name) {
+  m_variation_names.insert(var_name);
+}
+
 template <typename Helper>
 auto queryosity::varied<queryosity::todo<Helper>>::nominal() -> todo<Helper> & {
   return m_nominal;
@@ -121,21 +133,21 @@ auto queryosity::varied<queryosity::todo<Helper>>::nominal() const
 template <typename Helper>
 auto queryosity::varied<queryosity::todo<Helper>>::variation(
     const std::string &var_name) -> todo<Helper> & {
-  return (this->has_variation(var_name) ? m_variation_map.at(var_name)
-                                        : m_nominal);
+  auto var = m_variation_map.find(var_name);
+  return var != m_variation_map.end() ? var->second : m_nominal;
 }
 
 template <typename Helper>
 auto queryosity::varied<queryosity::todo<Helper>>::variation(
     const std::string &var_name) const -> todo<Helper> const & {
-  return (this->has_variation(var_name) ? m_variation_map.at(var_name)
-                                        : m_nominal);
+  auto var = m_variation_map.find(var_name);
+  return var != m_variation_map.end() ? var->second : m_nominal;
 }
 
 template <typename Helper>
 bool queryosity::varied<queryosity::todo<Helper>>::has_variation(
     const std::string &var_name) const {
-  return m_variation_map.find(var_name) != m_variation_map.end();
+  return m_variation_names.find(var_name) != m_variation_names.end();
 }
 
 template <typename Helper>
@@ -156,6 +168,10 @@ auto queryosity::varied<queryosity::todo<Helper>>::evaluate(Cols &&...cols)
       this->nominal().evaluate(std::forward<Cols>(cols).nominal()...));
   for (auto const &var_name :
        systematic::get_variation_names(*this, std::forward<Cols>(cols)...)) {
+    if (systematic::is_nominal(var_name, *this, cols...)) {
+      syst.share_nominal(var_name);
+      continue;
+    }
     syst.set_variation(var_name,
                        variation(var_name).evaluate(
                            std::forward<Cols>(cols).variation(var_name)...));
@@ -173,6 +189,10 @@ auto queryosity::varied<queryosity::todo<Helper>>::apply(Cols &&...cols)
       varied_type(this->nominal().apply(std::forward<Cols>(cols).nominal()...));
   for (auto const &var_name :
        systematic::get_variation_names(*this, std::forward<Cols>(cols)...)) {
+    if (systematic::is_nominal(var_name, *this, cols...)) {
+      syst.share_nominal(var_name);
+      continue;
+    }
     syst.set_variation(var_name,
                        variation(var_name).apply(
                            std::forward<Cols>(cols).variation(var_name)...));
@@ -188,6 +208,10 @@ auto queryosity::varied<queryosity::todo<Helper>>::fill(Nodes const &...columns)
   auto syst = varied(std::move(this->nominal().fill(columns.nominal()...)));
   for (auto const &var_name :
        systematic::get_variation_names(*this, columns...)) {
+    if (systematic::is_nominal(var_name, *this, columns...)) {
+      syst.share_nominal(var_name);
+      continue;
+    }
     syst.set_variation(var_name, std::move(variation(var_name).fill(
                                      columns.variation(var_name)...)));
   }
@@ -203,6 +227,17 @@ auto queryosity::varied<queryosity::todo<Helper>>::at(Node const &selection)
   auto syst = varied_type(this->nominal().at(selection.nominal()));
   for (auto const &var_name :
        systematic::get_variation_names(*this, selection)) {
+    if (systematic::is_nominal(var_name, *this, selection)) {
+      syst.share_nominal(var_name);
+      continue;
+    }
+    if (systematic::is_nominal(var_name, *this)) {
+      syst.set_variation(var_name, this->m_df->_book_variation(
+                                       this->nominal(),
+                                       selection.variation(var_name),
+                                       syst.nominal()));
+      continue;
+    }
     syst.set_variation(
         var_name, this->variation(var_name).at(selection.variation(var_name)));
   }
@@ -225,6 +260,17 @@ auto queryosity::varied<queryosity::todo<Helper>>::at(
        this](systematic::resolver<lazy<selection::node>> const &sel) {
         auto syst = varied_type(this->nominal().at(sel.nominal()));
         for (auto const &var_name : var_names) {
+          if (systematic::is_nominal(var_name, *this, sel)) {
+            syst.share_nominal(var_name);
+            continue;
+          }
+          if (systematic::is_nominal(var_name, *this)) {
+            syst.set_variation(var_name, this->m_df->_book_variation(
+                                             this->nominal(),
+                                             sel.variation(var_name),
+                                             syst.nominal()));
+            continue;
+          }
           syst.set_variation(
               var_name, this->variation(var_name).at(sel.variation(var_name)));
         }
@@ -246,6 +292,10 @@ auto queryosity::varied<queryosity::todo<Helper>>::operator()(Cols &&...cols)
       this->nominal().operator()(std::forward<Cols>(cols).nominal()...));
   for (auto const &var_name :
        systematic::get_variation_names(*this, std::forward<Cols>(cols)...)) {
+    if (systematic::is_nominal(var_name, *this, cols...)) {
+      syst.share_nominal(var_name);
+      continue;
+    }
     syst.set_variation(var_name,
                        variation(var_name).operator()(
                            std::forward<Cols>(cols).variation(var_name)...));
@@ -6,6 +6,8 @@
 
 #include <queryosity.hpp>
 
+#include <algorithm>
+#include <numeric>
 #include <random>
 #include <unordered_map>
 
@@ -71,4 +73,228 @@ TEST_CASE("multithreading consistency") {
     CHECK(queryosity_result1 == queryosity_result3);
     CHECK(queryosity_result1 == queryosity_result4);
   }
-}
\ No newline at end of file
+}
+
+TEST_CASE("asynchronous processing") {
+
+  auto test_data = generate_test_data();
+  auto correct_result = get_correct_result(test_data);
+
+  dataflow df(multithread::enable(2));
+  auto ds = df.load(dataset::input<qty::nlohmann::json>(test_data));
+  auto entry_value = ds.read(dataset::column<int>("x"));
+  auto all = df.filter(column::constant<bool>(true));
+  auto col = df.get(column::series(entry_value)).at(all);
+  auto result = col.result_async();
+  CHECK(result.get() == correct_result);
+  // booked after the analysis has finished: needs another one
+  auto again = df.get(column::series(entry_value)).at(all);
+  CHECK(again.result_async().get() == correct_result);
+  CHECK(col.result() == correct_result);
+  CHECK(again.result() == correct_result);
+}
+
+TEST_CASE("sampled processing") {
+
+  auto test_data = generate_test_data();
+
+  dataflow df(multithread::enable(2), dataset::sample(0.5, 1234));
+  auto ds = df.load(dataset::input<qty::nlohmann::json>(test_data));
+  auto all = df.filter(column::constant<bool>(true));
+  auto yield = df.get(selection::yield(all));
+  CHECK(yield.result().entries == 50);
+  CHECK(yield.result().value == doctest::Approx(100.0));
+  CHECK(yield.fraction() == doctest::Approx(0.5));
+}
+
+TEST_CASE("fraction of each query") {
+
+  auto test_data = generate_test_data();
+
+  dataflow df(multithread::disable(), dataset::granularity(10));
+  auto ds = df.load(dataset::input<qty::nlohmann::json>(test_data));
+  auto entry_value = ds.read(dataset::column<int>("x"));
+  auto all = df.filter(column::constant<bool>(true));
+  // done after the first part
+  auto head = df.get(column::series(entry_value, 10)).at(all);
+  CHECK(head.fraction() == doctest::Approx(0.1));
+  auto yield = df.get(selection::yield(all));
+  CHECK(yield.fraction() == doctest::Approx(1.0));
+  CHECK(head.fraction() == doctest::Approx(0.1));
+}
+
+TEST_CASE("entry ranges") {
+
+  auto test_data = generate_test_data();
+  auto correct_result = get_correct_result(test_data);
+
+  dataflow df_offset(multithread::enable(2), dataset::offset(10),
+                     dataset::head(20));
+  auto ds_offset =
+      df_offset.load(dataset::input<qty::nlohmann::json>(test_data));
+  auto x_offset = ds_offset.read(dataset::column<int>("x"));
+  auto all_offset = df_offset.filter(column::constant<bool>(true));
+  auto col_offset = df_offset.get(column::series(x_offset)).at(all_offset);
+  CHECK(col_offset.result() ==
+        std::vector<int>(correct_result.begin() + 10,
+                         correct_result.begin() + 30));
+
+  dataflow df_ranges(multithread::enable(2),
+                     dataset::ranges({{50, 55}, {5, 10}, {8, 12}}));
+  auto ds_ranges =
+      df_ranges.load(dataset::input<qty::nlohmann::json>(test_data));
+  auto i_ranges = ds_ranges.read(dataset::column<unsigned int>("index"));
+  auto all_ranges = df_ranges.filter(column::constant<bool>(true));
+  auto col_ranges = df_ranges.get(column::series(i_ranges)).at(all_ranges);
+  std::vector<unsigned int> correct_ranges{5,  6,  7,  8,  9,  10,
+                                           11, 50, 51, 52, 53, 54};
+  // (independent of the order in which the slots are merged)
+  auto ranges_result = col_ranges.result();
+  std::sort(ranges_result.begin(), ranges_result.end());
+  CHECK(ranges_result == correct_ranges);
+  CHECK(qty::dataset::partition::clip({{0, 40}, {40, 100}},
+                                      {{50, 55}, {5, 10}, {8, 12}, {12, 14}}) ==
+        qty::dataset::partition_t{{5, 14}, {50, 55}});
+}
+
+TEST_CASE("regrouped parts") {
+
+  auto test_data = generate_test_data();
+  auto correct_result = get_correct_result(test_data);
+
+  namespace partition = qty::dataset::partition;
+  qty::dataset::partition_t parts{{0, 3}, {3, 5}, {5, 20}};
+  CHECK(partition::regroup(parts, 6, false) ==
+        qty::dataset::partition_t{{0, 5}, {5, 20}});
+  CHECK(partition::regroup(parts, 6, true) ==
+        qty::dataset::partition_t{{0, 5}, {5, 10}, {10, 15}, {15, 20}});
+  // unsplittable parts are sampled whole
+  for (auto const &part : partition::sample(parts, 0.5, 1234, false)) {
+    CHECK(std::find(parts.begin(), parts.end(), part) != parts.end());
+  }
+
+  dataflow df(multithread::enable(2), dataset::granularity(7));
+  auto ds = df.load(dataset::input<qty::nlohmann::json>(test_data));
+  auto entry_value = ds.read(dataset::column<int>("x"));
+  auto all = df.filter(column::constant<bool>(true));
+  auto result = df.get(column::series(entry_value)).at(all).result();
+  auto sorted_result = correct_result;
+  std::sort(result.begin(), result.end());
+  std::sort(sorted_result.begin(), sorted_result.end());
+  CHECK(result == sorted_result);
+}
+
+TEST_CASE("aligned parts") {
+
+  namespace partition = qty::dataset::partition;
+  qty::dataset::partition_t parts_a{{0, 40}, {40, 100}};
+  qty::dataset::partition_t parts_b{{0, 30}, {30, 70}, {70, 100}};
+  CHECK(partition::align({parts_a, parts_b}) ==
+        qty::dataset::partition_t{{0, 100}});
+  CHECK(partition::align({parts_a, parts_b}, {false, true}) == parts_a);
+  CHECK(partition::align({parts_a, parts_b}, {true, true}) ==
+        qty::dataset::partition_t{{0, 30}, {30, 40}, {40, 70}, {70, 100}});
+  // never past the last entry of a shorter source
+  qty::dataset::partition_t parts_c{{0, 50}};
+  CHECK(partition::align({parts_a, parts_c}, {true, true}) ==
+        qty::dataset::partition_t{{0, 40}, {40, 50}});
+  CHECK(partition::align({parts_a, parts_c}, {false, true}) ==
+        qty::dataset::partition_t{{0, 40}, {40, 50}});
+  CHECK(partition::align({parts_c, parts_a}, {false, true}) == parts_c);
+
+  auto test_data = generate_test_data();
+  auto friend_data = nlohmann::json(test_data.begin(), test_data.begin() + 50);
+  dataflow df(multithread::enable(2));
+  auto ds = df.load(dataset::input<qty::nlohmann::json>(test_data));
+  auto ds_friend = df.load(dataset::input<qty::nlohmann::json>(friend_data));
+  auto x = ds.read(dataset::column<int>("x"));
+  auto x_friend = ds_friend.read(dataset::column<int>("x"));
+  auto all = df.filter(column::constant<bool>(true));
+  auto col = df.get(column::series(x)).at(all);
+  auto col_friend = df.get(column::series(x_friend)).at(all);
+  CHECK(col.result().size() == 50);
+  CHECK(col.result() == col_friend.result());
+}
+
+TEST_CASE("windowed processing") {
+
+  auto test_data = generate_test_data();
+  auto correct_result = get_correct_result(test_data);
+
+  dataflow df(multithread::enable(2), dataset::granularity(10),
+              dataset::window(25, true));
+  auto ds = df.load(dataset::input<qty::nlohmann::json>(test_data));
+  auto entry_value = ds.read(dataset::column<int>("x"));
+  auto all = df.filter(column::constant<bool>(true));
+  auto yield = df.get(selection::yield(all));
+  auto col = df.get(column::series(entry_value)).at(all);
+  std::vector<unsigned long long> windows;
+  std::vector<int> values;
+  df.on_window([&]() {
+    windows.push_back(yield.snapshot().entries);
+    auto snapshot = col.snapshot();
+    values.insert(values.end(), snapshot.begin(), snapshot.end());
+  });
+  windows.push_back(yield.result().entries);
+  auto last = col.result();
+  values.insert(values.end(), last.begin(), last.end());
+  // tumbling windows add up to the whole
+  CHECK(windows.size() > 1);
+  CHECK(std::accumulate(windows.begin(), windows.end(), 0ULL) == 100);
+  auto sorted_result = correct_result;
+  std::sort(values.begin(), values.end());
+  std::sort(sorted_result.begin(), sorted_result.end());
+  CHECK(values == sorted_result);
+}
+
+TEST_CASE("sliding windows") {
+
+  auto test_data = generate_test_data();
+  auto correct_result = get_correct_result(test_data);
+
+  // a window over the latest 30 entries, every part of 10
+  dataflow df(multithread::disable(), dataset::granularity(10),
+              dataset::window(30, 10));
+  auto ds = df.load(dataset::input<qty::nlohmann::json>(test_data));
+  auto entry_value = ds.read(dataset::column<int>("x"));
+  auto all = df.filter(column::constant<bool>(true));
+  auto yield = df.get(selection::yield(all));
+  auto col = df.get(column::series(entry_value)).at(all);
+  std::vector<unsigned long long> windows;
+  std::vector<std::vector<int>> values;
+  df.on_window([&]() {
+    windows.push_back(yield.snapshot().entries);
+    values.push_back(col.snapshot());
+  });
+  yield.result();
+  CHECK(windows == std::vector<unsigned long long>{10, 20, 30, 30, 30, 30, 30,
+                                                   30, 30, 30});
+  for (unsigned int i = 0; i < values.size(); ++i) {
+    auto end = std::min<size_t>(10 * (i + 1), correct_result.size());
+    auto begin = end < 30 ? 0 : end - 30;
+    CHECK(values[i] == std::vector<int>(correct_result.begin() + begin,
+                                        correct_result.begin() + end));
+  }
+}
+
+TEST_CASE("limited queries") {
+
+  auto test_data = generate_test_data();
+  auto correct_result = get_correct_result(test_data);
+
+  dataflow df(multithread::enable(2));
+  auto ds = df.load(dataset::input<qty::nlohmann::json>(test_data));
+  auto entry_value = ds.read(dataset::column<int>("x"));
+  auto all = df.filter(column::constant<bool>(true));
+  auto col = df.get(column::series(entry_value, 10)).at(all);
+  CHECK(col.result() == std::vector<int>(correct_result.begin(),
+                                         correct_result.begin() + 10));
+  // more than one part per slot
+  dataflow df_parts(multithread::enable(2), dataset::granularity(10));
+  auto ds_parts = df_parts.load(dataset::input<qty::nlohmann::json>(test_data));
+  auto x_parts = ds_parts.read(dataset::column<int>("x"));
+  auto all_parts = df_parts.filter(column::constant<bool>(true));
+  auto col_parts = df_parts.get(column::series(x_parts, 15)).at(all_parts);
+  CHECK(col_parts.result() == std::vector<int>(correct_result.begin(),
+                                               correct_result.begin() + 15));
+}
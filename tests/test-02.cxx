@@ -13,12 +13,40 @@ namespace selection = qty::selection;
 namespace query = qty::query;
 namespace systematic = qty::systematic;
 
+#include <atomic>
 #include <random>
 #include <unordered_map>
 
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 #include "doctest.h"
 
+// keeps count of how many times it has been negated
+struct tracked {
+  unsigned int value;
+  static inline std::atomic<unsigned int> nnegated = 0;
+  tracked operator-() const {
+    ++nnegated;
+    return {value};
+  }
+  tracked operator+(tracked const &other) const {
+    return {value + other.value};
+  }
+};
+
+// keeps count of the entries it has been executed for
+class executed : public column::definition<unsigned int(unsigned int)> {
+public:
+  static inline std::atomic<unsigned int> nexecuted = 0;
+  virtual unsigned int
+  evaluate(column::observable<unsigned int> w) const override {
+    return w.value();
+  }
+  virtual void execute(unsigned int slot, unsigned long long entry) override {
+    column::definition<unsigned int(unsigned int)>::execute(slot, entry);
+    ++nexecuted;
+  }
+};
+
 TEST_CASE("correctness & consistency of selections") {
 
   // generate random data
@@ -87,6 +115,11 @@ TEST_CASE("correctness & consistency of selections") {
   auto [sumw_ab, sumw_bc] = df.get(selection::yield(cut_ab, cut_bc));
   auto [sumw_none, sumw_abc] = df.get(selection::yield(cut_none, cut_abc));
 
+  auto regions = df.get(selection::yield(
+      std::vector<qty::lazy<selection::node>>{cut_a, cut_ab, cut_b, cut_none,
+                                              cut_abc, cut_a.filter(cat == b),
+                                              cut_a.filter(cat == a)}));
+
   SUBCASE("branching") {
     CHECK(sumw_a.result().value == correct_sumw_a);
     CHECK(sumw_b.result().value == correct_sumw_b);
@@ -97,4 +130,84 @@ TEST_CASE("correctness & consistency of selections") {
     CHECK(sumw_abc.result().value == correct_sumw_abc);
     CHECK(sumw_none.result().value == 0);
   }
-}
\ No newline at end of file
+
+  SUBCASE("tally") {
+    auto yields = regions.result();
+    CHECK(yields.size() == 7);
+    CHECK(yields[0].value == correct_sumw_a);
+    CHECK(yields[1].value == correct_sumw_a + correct_sumw_b);
+    CHECK(yields[2].value == correct_sumw_b);
+    CHECK(yields[3].value == 0);
+    CHECK(yields[4].value == correct_sumw_abc);
+    CHECK(yields[4].entries == sumw_abc.result().entries);
+    CHECK(yields[5].value == 0);
+    CHECK(yields[6].value == correct_sumw_a);
+  }
+
+  auto is_a = df.define(
+      column::expression([](std::string const &c) { return c == "a"; }));
+
+  SUBCASE("deduplication") {
+    CHECK((cat == a).get_slots() == (cat == a).get_slots());
+    CHECK(is_a(cat).get_slots() == is_a(cat).get_slots());
+    CHECK((cat == a).get_slots() != (cat == b).get_slots());
+  }
+
+  SUBCASE("shared operands") {
+    tracked::nnegated = 0;
+    auto trk = df.define(column::expression(
+        [](unsigned int w) { return tracked{w}; }))(w);
+    auto neg = -trk;
+    auto thrice = neg + neg + neg;
+    auto all = df.filter(column::constant(true));
+    auto sums = df.get(column::series(thrice)).at(all).result();
+    CHECK(sums.size() == nentries);
+    // computed once per entry, however many columns it is an operand of
+    CHECK(tracked::nnegated == nentries);
+  }
+
+  SUBCASE("overridden execute") {
+    executed::nexecuted = 0;
+    auto exe = df.define(column::definition<executed>())(w);
+    auto none = df.get(column::series(exe)).at(cut_none).result();
+    CHECK(none.empty());
+    // executed for each entry, even if its value is never needed
+    CHECK(executed::nexecuted == nentries);
+  }
+
+  SUBCASE("intersection") {
+    auto not_b_nor_c =
+        weighted.filter(df.define(column::conjunction(cat != b, cat != c)));
+    auto chained = weighted.filter(cat != b).filter(cat != c);
+    auto [sumw_itx, sumw_chained] =
+        df.get(selection::yield(not_b_nor_c, chained));
+    CHECK(sumw_itx.result().value == correct_sumw_a);
+    CHECK(sumw_itx.result().entries == sumw_chained.result().entries);
+  }
+}
+
+TEST_CASE("errors of yields over many parts") {
+  nlohmann::json test_data;
+  unsigned int nentries = 100;
+  double correct_sumw2 = 0;
+  for (unsigned int i = 0; i < nentries; ++i) {
+    unsigned int w = i % 3 + 1;
+    test_data.emplace_back<nlohmann::json>({{"w", w}});
+    correct_sumw2 += w * w;
+  }
+
+  // each slot processes several parts
+  dataflow df(multithread::enable(2), dataset::granularity(10));
+  auto w = df.read(dataset::input<json>(test_data),
+                   dataset::column<unsigned int>("w"));
+  auto weighted = df.weight(w);
+  auto all = weighted.filter(df.define(column::constant(true)));
+
+  auto cnt = df.get(selection::yield(all));
+  auto cnts = df.get(selection::yield(
+      std::vector<qty::lazy<selection::node>>{weighted, all}));
+
+  CHECK(cnt.result().error == doctest::Approx(std::sqrt(correct_sumw2)));
+  CHECK(cnts.result()[0].error == doctest::Approx(std::sqrt(correct_sumw2)));
+  CHECK(cnts.result()[1].error == doctest::Approx(std::sqrt(correct_sumw2)));
+}
@@ -70,6 +70,15 @@ TEST_CASE("propagation of systematic variations")
         CHECK(wsumx_wvar == wsumx["vary_w"].result());
     }
 
+    auto x_var = ds.read(dataset::column<double>("x_var"));
+    auto wsumx_var = df.get(query::output<qty::wsum>()).fill(x_var).at(weighted);
+
+    SUBCASE("varied reads")
+    {
+        CHECK(x_var.get_slots() != x.variation("vary_x").get_slots());
+        CHECK(wsumx_var.nominal().result() == wsumx_xvar);
+    }
+
     auto one = df.define(column::constant<unsigned int>(1));
     auto two = df.define(column::constant<unsigned int>(2));
     auto one_or_two = df.vary(column::nominal(one), {{"two", two}});
@@ -87,4 +96,33 @@ TEST_CASE("propagation of systematic variations")
         CHECK(std::accumulate(always_no.begin(), always_no.end(), 0) == 0);
         CHECK(std::accumulate(always_yes.begin(), always_yes.end(), 0) == test_data.size());
     }
-}
\ No newline at end of file
+
+    auto one_or_one = df.vary(column::nominal(one), {{"same", one}});
+    auto two_or_two_again = one_or_one + one;
+    auto sum_two = df.get(column::series(two_or_two_again)).at(all);
+
+    SUBCASE("shared nominal")
+    {
+        CHECK(one_or_one.has_variation("same"));
+        CHECK(two_or_two_again.variation("same").get_slots() ==
+              two_or_two_again.nominal().get_slots());
+        CHECK(sum_two.variation("same").get_slots() ==
+              sum_two.nominal().get_slots());
+        CHECK(sum_two["same"].result() == sum_two.nominal().result());
+    }
+
+    auto x_vec = df.vectorize(x);
+    auto x_times = df.define(column::expression([](double x, unsigned int w) { return x * w; }));
+    auto wx_vec = x_times(x_vec, w);
+    auto wx_ref = x_times(x, w);
+    auto wx_vec_series = df.get(column::series(wx_vec)).at(all);
+    auto wx_ref_series = df.get(column::series(wx_ref)).at(all);
+
+    SUBCASE("vectorized lanes")
+    {
+        CHECK(wx_vec.get_variation_names() == wx_ref.get_variation_names());
+        CHECK(wx_vec_series.nominal().result() == wx_ref_series.nominal().result());
+        CHECK(wx_vec_series["vary_x"].result() == wx_ref_series["vary_x"].result());
+        CHECK(wx_vec_series["vary_w"].result() == wx_ref_series["vary_w"].result());
+    }
+}
@@ -0,0 +1,377 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+#include <queryosity/nlohmann/json.hpp>
+#include <nlohmann/json.hpp>
+
+#include <queryosity.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <random>
+
+using dataflow = qty::dataflow;
+namespace multithread = qty::multithread;
+namespace multiprocess = qty::multiprocess;
+namespace dataset = qty::dataset;
+namespace column = qty::column;
+namespace query = qty::query;
+namespace selection = qty::selection;
+
+nlohmann::json generate_test_data() {
+  nlohmann::json test_data;
+  std::random_device rd;
+  std::mt19937 gen(rd());
+  unsigned int nentries = 100;
+  std::uniform_int_distribution<int> random_value(0, nentries);
+  for (unsigned int i = 0; i < nentries; ++i) {
+    auto x = random_value(gen);
+    test_data.emplace_back(nlohmann::json{{"x", x}, {"pass", x > 50}});
+  }
+  return test_data;
+}
+
+// counts every read-out of its columns and every executed entry
+class counted : public qty::dataset::reader<counted> {
+
+public:
+  template <typename T> class item;
+
+public:
+  counted(nlohmann::json const &data) : m_data(data) {}
+  virtual ~counted() = default;
+
+  virtual void parallelize(unsigned int) final override {}
+
+  virtual std::vector<std::pair<unsigned long long, unsigned long long>>
+  partition() final override {
+    std::vector<std::pair<unsigned long long, unsigned long long>> parts;
+    unsigned long long nentries = m_data.size();
+    for (unsigned long long begin = 0; begin < nentries; begin += 10) {
+      parts.emplace_back(begin, std::min(begin + 10, nentries));
+    }
+    return parts;
+  }
+
+  virtual bool is_splittable() const final override { return true; }
+
+  virtual void execute(unsigned int, unsigned long long) final override {
+    ++nexecuted;
+  }
+
+  template <typename T>
+  std::unique_ptr<item<T>> read(unsigned int, const std::string &name) const {
+    return std::make_unique<item<T>>(m_data, name);
+  }
+
+  static std::atomic<unsigned long long> nread;
+  static std::atomic<unsigned long long> nexecuted;
+
+protected:
+  nlohmann::json const m_data;
+};
+
+std::atomic<unsigned long long> counted::nread = 0;
+std::atomic<unsigned long long> counted::nexecuted = 0;
+
+template <typename T> class counted::item : public qty::column::reader<T> {
+
+public:
+  item(nlohmann::json const &data, std::string const &name)
+      : m_data(data), m_name(name) {}
+  virtual ~item() = default;
+
+  virtual T const &read(unsigned int,
+                        unsigned long long entry) const final override {
+    ++counted::nread;
+    m_value = m_data[entry][m_name].template get<T>();
+    return m_value;
+  }
+
+protected:
+  nlohmann::json const &m_data;
+  std::string m_name;
+  mutable T m_value;
+};
+
+TEST_CASE("cached dataset") {
+
+  auto test_data = generate_test_data();
+  std::vector<int> correct_all, correct_pass;
+  for (unsigned int i = 0; i < test_data.size(); ++i) {
+    auto x = test_data.at(i).at("x").template get<int>();
+    correct_all.push_back(x);
+    if (test_data.at(i).at("pass").template get<bool>())
+      correct_pass.push_back(x);
+  }
+
+  counted::nread = 0;
+  counted::nexecuted = 0;
+
+  dataflow df(multithread::enable(4));
+  auto ds = df.load(dataset::input<dataset::cached<counted>>(test_data));
+  auto [x, pass] = ds.read(dataset::column<int>("x"),
+                           dataset::column<bool>("pass"));
+
+  auto all = df.filter(column::constant(true));
+  auto x_all = df.get(column::series(x)).at(all).result();
+  CHECK(x_all == correct_all);
+  CHECK(counted::nexecuted == test_data.size());
+  CHECK(counted::nread == 2 * test_data.size());
+
+  // second pass served from the cache
+  counted::nread = 0;
+  counted::nexecuted = 0;
+  auto passed = df.filter(pass);
+  auto x_pass = df.get(column::series(x)).at(passed).result();
+  CHECK(x_pass == correct_pass);
+  CHECK(counted::nexecuted == 0);
+  CHECK(counted::nread == 0);
+}
+
+class stream : public qty::dataset::reader<stream> {
+
+public:
+  template <typename T> class item;
+
+public:
+  stream(std::vector<int> const &data, unsigned long long nentries_per_chunk)
+      : m_data(data), m_nentries_per_chunk(nentries_per_chunk), m_nfetched(0) {}
+  virtual ~stream() = default;
+
+  virtual void parallelize(unsigned int) final override {}
+
+  virtual std::vector<std::pair<unsigned long long, unsigned long long>>
+  partition() final override {
+    return {};
+  }
+
+  virtual bool is_streaming() const final override { return true; }
+
+  virtual bool fetch(
+      std::pair<unsigned long long, unsigned long long> &part) final override {
+    if (m_nfetched == m_data.size())
+      return false;
+    part.first = m_nfetched;
+    m_nfetched =
+        std::min<unsigned long long>(m_nfetched + m_nentries_per_chunk,
+                                     m_data.size());
+    part.second = m_nfetched;
+    return true;
+  }
+
+  template <typename T>
+  std::unique_ptr<item<T>> read(unsigned int, const std::string &) const {
+    return std::make_unique<item<T>>(m_data);
+  }
+
+protected:
+  std::vector<int> m_data;
+  unsigned long long m_nentries_per_chunk;
+  unsigned long long m_nfetched;
+};
+
+template <typename T> class stream::item : public qty::column::reader<T> {
+
+public:
+  item(std::vector<int> const &data) : m_data(data) {}
+  virtual ~item() = default;
+
+  virtual T const &read(unsigned int,
+                        unsigned long long entry) const final override {
+    m_value = m_data[entry];
+    return m_value;
+  }
+
+protected:
+  std::vector<int> const &m_data;
+  mutable T m_value;
+};
+
+TEST_CASE("streaming dataset") {
+
+  auto test_data = generate_test_data();
+  std::vector<int> correct_all;
+  for (unsigned int i = 0; i < test_data.size(); ++i) {
+    correct_all.push_back(test_data.at(i).at("x").template get<int>());
+  }
+
+  dataflow df(multithread::enable(4));
+  auto ds = df.load(dataset::input<stream>(correct_all, 7));
+  auto x = ds.read(dataset::column<int>("x"));
+
+  auto all = df.filter(column::constant(true));
+  auto x_all = df.get(column::series(x)).at(all).result();
+
+  // chunks are dispatched to slots in no particular order
+  std::sort(x_all.begin(), x_all.end());
+  auto const data = correct_all;
+  std::sort(correct_all.begin(), correct_all.end());
+  CHECK(x_all == correct_all);
+
+  SUBCASE("row limit") {
+    dataflow df_head(multithread::enable(4), dataset::head(20));
+    auto ds_head = df_head.load(dataset::input<stream>(data, 7));
+    auto x_head = ds_head.read(dataset::column<int>("x"));
+    auto all_head = df_head.filter(column::constant(true));
+    auto x_head_all = df_head.get(column::series(x_head)).at(all_head).result();
+    std::sort(x_head_all.begin(), x_head_all.end());
+    std::vector<int> correct_head(data.begin(), data.begin() + 20);
+    std::sort(correct_head.begin(), correct_head.end());
+    CHECK(x_head_all == correct_head);
+  }
+
+  SUBCASE("unsupported options") {
+    dataflow df_offset(multithread::enable(4), dataset::offset(10));
+    auto ds_offset = df_offset.load(dataset::input<stream>(data, 7));
+    auto x_offset = ds_offset.read(dataset::column<int>("x"));
+    auto all_offset = df_offset.filter(column::constant(true));
+    auto x_offset_all = df_offset.get(column::series(x_offset)).at(all_offset);
+    CHECK_THROWS_AS(x_offset_all.result(), std::logic_error);
+  }
+}
+
+// values of its column are shifted under any variation
+class shiftable : public qty::dataset::reader<shiftable> {
+
+public:
+  template <typename T> class item;
+
+public:
+  shiftable(std::vector<int> const &data) : m_data(data) {}
+  virtual ~shiftable() = default;
+
+  virtual void parallelize(unsigned int) final override {}
+
+  virtual std::vector<std::pair<unsigned long long, unsigned long long>>
+  partition() final override {
+    return {{0, m_data.size()}};
+  }
+
+  template <typename T>
+  std::unique_ptr<item<T>> read(unsigned int, const std::string &) const {
+    return std::make_unique<item<T>>(m_data);
+  }
+
+protected:
+  std::vector<int> m_data;
+};
+
+template <typename T> class shiftable::item : public qty::column::reader<T> {
+
+public:
+  item(std::vector<int> const &data) : m_data(data), m_shift(0) {}
+  virtual ~item() = default;
+
+  virtual void vary(const std::string &) final override { m_shift = 1000; }
+
+  virtual T const &read(unsigned int,
+                        unsigned long long entry) const final override {
+    m_value = m_data[entry] + m_shift;
+    return m_value;
+  }
+
+protected:
+  std::vector<int> const &m_data;
+  T m_shift;
+  mutable T m_value;
+};
+
+TEST_CASE("pipelined dataset") {
+
+  auto test_data = generate_test_data();
+  std::vector<int> correct_all, correct_pass;
+  for (unsigned int i = 0; i < test_data.size(); ++i) {
+    auto x = test_data.at(i).at("x").template get<int>();
+    correct_all.push_back(x);
+    if (test_data.at(i).at("pass").template get<bool>())
+      correct_pass.push_back(x);
+  }
+
+  dataflow df(multithread::enable(4));
+  auto in = dataset::input<dataset::pipelined<qty::nlohmann::json>>(test_data);
+  in.ds->buffer(7, 2);
+  auto ds = df.load(std::move(in));
+  auto [x, pass] = ds.read(dataset::column<int>("x"),
+                           dataset::column<bool>("pass"));
+
+  auto all = df.filter(column::constant(true));
+  auto x_all = df.get(column::series(x)).at(all).result();
+
+  // second pass through a new reader thread
+  auto passed = df.filter(pass);
+  auto x_pass = df.get(column::series(x)).at(passed).result();
+
+  // batches are dispatched to slots in no particular order
+  std::sort(x_all.begin(), x_all.end());
+  std::sort(x_pass.begin(), x_pass.end());
+  std::sort(correct_all.begin(), correct_all.end());
+  std::sort(correct_pass.begin(), correct_pass.end());
+
+  SUBCASE("first pass") { CHECK(x_all == correct_all); }
+
+  SUBCASE("second pass") { CHECK(x_pass == correct_pass); }
+
+  SUBCASE("varied column") {
+    dataflow df_var(multithread::enable(4));
+    auto in_var = dataset::input<dataset::pipelined<shiftable>>(correct_all);
+    in_var.ds->buffer(7, 2);
+    auto ds_var = df_var.load(std::move(in_var));
+    auto y = ds_var.vary(dataset::column<int>("x"), {{"shift", "x"}});
+    auto y_nom = ds_var.read(dataset::column<int>("x"));
+    auto all_var = df_var.filter(column::constant(true));
+    auto y_all = df_var.get(column::series(y)).at(all_var);
+    auto y_nom_all = df_var.get(column::series(y_nom)).at(all_var).result();
+    auto y_shift_all = y_all["shift"].result();
+    std::sort(y_nom_all.begin(), y_nom_all.end());
+    std::sort(y_shift_all.begin(), y_shift_all.end());
+    // the variation is captured apart from the nominal
+    CHECK(y_nom_all == correct_all);
+    CHECK(y_all.nominal().result().size() == correct_all.size());
+    CHECK(y_shift_all.front() == correct_all.front() + 1000);
+    CHECK(y_shift_all.back() == correct_all.back() + 1000);
+  }
+}
+
+TEST_CASE("multi-process processing") {
+
+  auto test_data = generate_test_data();
+  std::vector<int> correct_all;
+  unsigned long long correct_npass = 0;
+  for (unsigned int i = 0; i < test_data.size(); ++i) {
+    correct_all.push_back(test_data.at(i).at("x").template get<int>());
+    correct_npass += test_data.at(i).at("pass").template get<bool>();
+  }
+
+  dataflow df(multiprocess::enable(4), dataset::granularity(10));
+  auto ds = df.load(dataset::input<qty::nlohmann::json>(test_data));
+  auto [x, pass] = ds.read(dataset::column<int>("x"),
+                           dataset::column<bool>("pass"));
+
+  auto all = df.filter(column::constant(true));
+  auto passed = all.filter(pass);
+  auto x_all = df.get(column::series(x)).at(all);
+  auto n_pass = df.get(selection::yield(passed));
+  auto n_regions = df.get(selection::yield(std::vector{all, passed}));
+
+  // each worker process is handed a contiguous share of the dataset
+  SUBCASE("series") { CHECK(x_all.result() == correct_all); }
+
+  SUBCASE("yield") {
+    CHECK(n_pass.result().entries == correct_npass);
+    CHECK(n_pass.result().value == doctest::Approx(correct_npass));
+    CHECK(n_pass.fraction() == doctest::Approx(1.0));
+  }
+
+  SUBCASE("tally") {
+    auto yields = n_regions.result();
+    CHECK(yields.size() == 2);
+    CHECK(yields[0].entries == test_data.size());
+    CHECK(yields[1].entries == correct_npass);
+  }
+
+  SUBCASE("asynchronous analysis") {
+    CHECK_THROWS_AS(x_all.result_async(), std::logic_error);
+    CHECK(x_all.result() == correct_all);
+  }
+}